@@ -0,0 +1,110 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstdint>
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Mutex.hpp>
+
+#include "Benchmark.hpp"
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr uint32_t rounds {1000};
+
+// A spin count of 0 is the blocking (non-adaptive) reference.
+constexpr uint32_t spinCounts[] {0, 100, 1000, 10000};
+constexpr uint32_t holdCycles[] {0, 250, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000};
+
+struct Context
+{
+  rtos::Mutex& mutex;
+  const uint32_t holdCycles;
+  const TaskHandle_t waiter;
+  std::atomic<uint32_t> turn;
+};
+
+// Runs on the other core: locks the mutex, hands the turn to the waiter and holds the mutex for the configured cycles.
+void HolderTask(void* param)
+{
+  Context& ctx = *static_cast<Context*>(param);
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    while (ctx.turn.load() != (2 * round))
+    {
+    }
+
+    ctx.mutex.Lock();
+    ctx.turn.store((2 * round) + 1);
+    BusyWait(ctx.holdCycles);
+    ctx.mutex.Unlock();
+  }
+
+  xTaskNotifyGive(ctx.waiter);
+  vTaskDelete(nullptr);
+}
+
+void Measure(uint32_t spinCount, uint32_t hold)
+{
+  rtos::Mutex mutex {spinCount};
+  Context ctx {mutex, hold, xTaskGetCurrentTaskHandle(), {0}};
+
+  const BaseType_t otherCore = (0 == xPortGetCoreID()) ? 1 : 0;
+  xTaskCreatePinnedToCore(HolderTask, "holder", 2048, &ctx, uxTaskPriorityGet(nullptr), nullptr, otherCore);
+
+  uint64_t totalCycles {0};
+  uint32_t maxCycles {0};
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    while (ctx.turn.load() != ((2 * round) + 1))
+    {
+    }
+
+    const uint32_t start = GetCycleCount();
+    mutex.Lock();
+    const uint32_t cycles = GetCycleCount() - start;
+    mutex.Unlock();
+
+    ctx.turn.store((2 * round) + 2);
+
+    totalCycles += cycles;
+    maxCycles = (cycles > maxCycles) ? cycles : maxCycles;
+  }
+
+  // Wait until the holder task has finished, before the mutex and the context go out of scope.
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+  Serial.printf("adaptive_mutex,%u,%u,%u,%u\n",
+                static_cast<unsigned>(spinCount), static_cast<unsigned>(hold),
+                static_cast<unsigned>(totalCycles / rounds), static_cast<unsigned>(maxCycles));
+}
+
+} // namespace
+
+void RunAdaptiveMutexBenchmark()
+{
+  // The crossover point is the hold time at which an adaptive mutex becomes slower than the blocking mutex (spin_count 0).
+  Serial.println("benchmark,spin_count,hold_cycles,avg_lock_cycles,max_lock_cycles");
+
+  for (const uint32_t spinCount : spinCounts)
+  {
+    for (const uint32_t hold : holdCycles)
+    {
+      Measure(spinCount, hold);
+    }
+  }
+}
+
+} // namespace benchmark
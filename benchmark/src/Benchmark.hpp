@@ -0,0 +1,59 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A851F679FC1E4AC88B0AACF2735C0544
+#define HEADER_A851F679FC1E4AC88B0AACF2735C0544
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+namespace benchmark
+{
+
+/**
+ * @returns the cycle counter of the calling core.
+ * @note The cycle counters of the cores are not synchronized, only compare values taken on the same core.
+ */
+inline uint32_t GetCycleCount()
+{
+  return ESP.getCycleCount();
+}
+
+/**
+ * @brief Busy waits for the given number of cpu cycles.
+ * @param[in] cycles number of cycles to wait.
+ */
+inline void BusyWait(uint32_t cycles)
+{
+  const uint32_t start = GetCycleCount();
+  while ((GetCycleCount() - start) < cycles)
+  {
+  }
+}
+
+/**
+ * @brief Measures the cost of an adaptive rtos::Mutex against a blocking rtos::Mutex, when the holder runs on the other core.
+ *        Prints one CSV line per spin count and hold time.
+ */
+void RunAdaptiveMutexBenchmark();
+
+/**
+ * @brief Runs an rtos::Executor, whose coroutines await an rtos::AsyncSignal, an rtos::Queue and an rtos::Mutex.
+ *        Prints one CSV line per awaitable with its wakeup latency and the number of wrong results.
+ * @note Requires C++20, build the env esp32dev-cpp20. Otherwise a single line reports the benchmark as skipped.
+ */
+void RunCoroutineBenchmark();
+
+/**
+ * @brief Measures the cycles of locking each lock primitive of the library uncontended, contended by a task on the same core
+ *        and contended by a task on the other core.
+ *        Prints one CSV line per primitive and case.
+ */
+void RunLockBenchmark();
+
+} // namespace benchmark
+
+#endif // HEADER_A851F679FC1E4AC88B0AACF2735C0544
@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstdint>
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Coroutine.hpp>
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/Queue.hpp>
+
+#include "Benchmark.hpp"
+
+#if defined(KERNELAPI_HAS_COROUTINES)
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr uint32_t rounds {1000};
+constexpr uint32_t coroutineCount {4};
+
+// Collects the cycle counts of the rounds of a single awaitable and the number of wrong results.
+struct Statistic
+{
+  void Add(uint32_t cycles)
+  {
+    total += cycles;
+    max = (cycles > max) ? cycles : max;
+    ++count;
+  }
+
+  void Print(const char* awaitable) const
+  {
+    Serial.printf("coroutine,%s,%u,%u,%u,%u\n", awaitable, static_cast<unsigned>(count),
+                  static_cast<unsigned>((0 < count) ? (total / count) : 0), static_cast<unsigned>(max),
+                  static_cast<unsigned>(errors));
+  }
+
+  uint64_t total {0};
+  uint32_t max {0};
+  uint32_t count {0};
+  uint32_t errors {0};
+};
+
+struct Context
+{
+  rtos::Executor executor {1};
+  rtos::AsyncSignal signal {};
+  rtos::Queue<uint32_t, 4> queue {};
+  rtos::Mutex mutex {};
+  TaskHandle_t waiter {nullptr};
+  std::atomic<uint32_t> sentAt {0};
+  std::atomic<uint32_t> finished {0};
+  bool locked {false};
+  Statistic signalStats {};
+  Statistic receiveStats {};
+  Statistic lockStats {};
+};
+
+// The executor wakes up immediately, thus the cycles measure the notification, the context switch and the resumption.
+rtos::Coroutine WaitForSignal(Context& ctx)
+{
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    co_await ctx.signal.Wait();
+    ctx.signalStats.Add(GetCycleCount() - ctx.sentAt.load());
+    xTaskNotifyGive(ctx.waiter);
+  }
+  ++ctx.finished;
+}
+
+// The queue is polled, thus the cycles are dominated by the poll interval of the executor.
+rtos::Coroutine ReceiveItems(Context& ctx)
+{
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    const uint32_t item = co_await rtos::ReceiveAsync(ctx.queue);
+    ctx.receiveStats.Add(GetCycleCount() - ctx.sentAt.load());
+    ctx.receiveStats.errors += (round == item) ? 0 : 1;
+    xTaskNotifyGive(ctx.waiter);
+  }
+  ++ctx.finished;
+}
+
+// Two coroutines compete for the mutex, the other one runs while the mutex is held.
+rtos::Coroutine LockMutex(Context& ctx)
+{
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    const uint32_t start = GetCycleCount();
+    co_await rtos::LockAsync(ctx.mutex);
+    ctx.lockStats.Add(GetCycleCount() - start);
+    ctx.lockStats.errors += ctx.locked ? 1 : 0;
+    ctx.locked = true;
+
+    co_await rtos::YieldAsync();
+
+    ctx.locked = false;
+    ctx.mutex.Unlock();
+  }
+  ++ctx.finished;
+}
+
+void ExecutorTask(void* param)
+{
+  static_cast<rtos::Executor*>(param)->Run();
+}
+
+} // namespace
+
+void RunCoroutineBenchmark()
+{
+  Serial.println("benchmark,awaitable,rounds,avg_cycles,max_cycles,errors");
+
+  Context ctx {};
+  ctx.waiter = xTaskGetCurrentTaskHandle();
+
+  ctx.executor.Spawn(WaitForSignal(ctx));
+  ctx.executor.Spawn(ReceiveItems(ctx));
+  ctx.executor.Spawn(LockMutex(ctx));
+  ctx.executor.Spawn(LockMutex(ctx));
+
+  // The executor preempts this task on the same core, so the cycle counters are comparable.
+  TaskHandle_t executorTask {nullptr};
+  xTaskCreatePinnedToCore(ExecutorTask, "executor", 4096, &ctx.executor, uxTaskPriorityGet(nullptr) + 1, &executorTask, xPortGetCoreID());
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    ctx.sentAt.store(GetCycleCount());
+    ctx.signal.Signal();
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    ctx.sentAt.store(GetCycleCount());
+    ctx.queue.Send(round, portMAX_DELAY);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+
+  // The lock rounds do not wait for this task, they are done long before.
+  while (coroutineCount != ctx.finished.load())
+  {
+    vTaskDelay(1);
+  }
+
+  // The executor blocks without any coroutine, before the context goes out of scope.
+  vTaskDelete(executorTask);
+
+  ctx.signalStats.Print("AsyncSignal");
+  ctx.receiveStats.Print("ReceiveAsync");
+  ctx.lockStats.Print("LockAsync");
+}
+
+} // namespace benchmark
+
+#else
+
+namespace benchmark
+{
+
+void RunCoroutineBenchmark()
+{
+  Serial.println("benchmark,awaitable,rounds,avg_cycles,max_cycles,errors");
+  Serial.println("coroutine,skipped: requires -std=gnu++20, see env:esp32dev-cpp20");
+}
+
+} // namespace benchmark
+
+#endif // KERNELAPI_HAS_COROUTINES
@@ -0,0 +1,341 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstdint>
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/InlineMutex.hpp>
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/NullMutex.hpp>
+#include <kernelapi/rtos/RecursiveMutex.hpp>
+#include <kernelapi/rtos/ScopedLock.hpp>
+#include <kernelapi/rtos/SeqLock.hpp>
+#include <kernelapi/rtos/SharedLockGuard.hpp>
+#include <kernelapi/rtos/SharedMutex.hpp>
+#include <kernelapi/rtos/SpinLock.hpp>
+#include <kernelapi/rtos/StaticMutex.hpp>
+#include <kernelapi/rtos/StaticRecursiveMutex.hpp>
+#include <kernelapi/rtos/TripleBuffer.hpp>
+#include <kernelapi/rtos/UniqueLock.hpp>
+
+#include "Benchmark.hpp"
+
+namespace benchmark
+{
+
+namespace
+{
+
+constexpr uint32_t rounds {1000};
+constexpr uint32_t holdCycles {2000};
+constexpr UBaseType_t benchmarkPriority {5};
+
+// Collects the cycle counts of the rounds of a single measurement.
+class Statistic
+{
+  public:
+  void Add(uint32_t cycles)
+  {
+    _total += cycles;
+    _min = (cycles < _min) ? cycles : _min;
+    _max = (cycles > _max) ? cycles : _max;
+    ++_count;
+  }
+
+  void Print(const char* primitive, const char* scenario, uint32_t hold) const
+  {
+    Serial.printf("lock,%s,%s,%u,%u,%u,%u\n", primitive, scenario, static_cast<unsigned>(hold),
+                  static_cast<unsigned>(_total / _count), static_cast<unsigned>(_min), static_cast<unsigned>(_max));
+  }
+
+  private:
+  uint64_t _total {0};
+  uint32_t _min {UINT32_MAX};
+  uint32_t _max {0};
+  uint32_t _count {0};
+};
+
+// The access of the measured task, the holder always locks exclusively.
+struct ExclusiveAccess
+{
+  template <typename MUTEX>
+  static void Lock(MUTEX& mutex)
+  {
+    mutex.Lock();
+  }
+
+  template <typename MUTEX>
+  static void Unlock(MUTEX& mutex)
+  {
+    mutex.Unlock();
+  }
+};
+
+struct SharedAccess
+{
+  template <typename MUTEX>
+  static void Lock(MUTEX& mutex)
+  {
+    mutex.LockShared();
+  }
+
+  template <typename MUTEX>
+  static void Unlock(MUTEX& mutex)
+  {
+    mutex.UnlockShared();
+  }
+};
+
+template <typename MUTEX>
+struct Context
+{
+  MUTEX& mutex;
+  const TaskHandle_t waiter;
+  std::atomic<uint32_t> turn;
+};
+
+// Measures \a op, which has to leave the primitive in the state it found it.
+template <typename OP>
+void MeasureUncontended(const char* primitive, const char* scenario, OP op)
+{
+  Statistic statistic;
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    const uint32_t start = GetCycleCount();
+    op();
+    statistic.Add(GetCycleCount() - start);
+  }
+
+  statistic.Print(primitive, scenario, 0);
+}
+
+template <typename MUTEX>
+void MeasureUncontendedPair(const char* primitive, MUTEX& mutex)
+{
+  MeasureUncontended(primitive, "uncontended", [&mutex]() {
+    mutex.Lock();
+    mutex.Unlock();
+  });
+}
+
+// Runs on the core of the measured task with a lower priority: locks the mutex and wakes up the measured task,
+// which preempts the holder and blocks on the mutex, so the holder inherits its priority until it releases the mutex.
+template <typename MUTEX>
+void SameCoreHolderTask(void* param)
+{
+  Context<MUTEX>& ctx = *static_cast<Context<MUTEX>*>(param);
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    ctx.mutex.Lock();
+    xTaskNotifyGive(ctx.waiter);
+    BusyWait(holdCycles);
+    ctx.mutex.Unlock();
+  }
+
+  xTaskNotifyGive(ctx.waiter);
+  vTaskDelete(nullptr);
+}
+
+template <typename MUTEX, typename ACCESS = ExclusiveAccess>
+void MeasureSameCore(const char* primitive, MUTEX& mutex)
+{
+  Context<MUTEX> ctx {mutex, xTaskGetCurrentTaskHandle(), {0}};
+  xTaskCreatePinnedToCore(SameCoreHolderTask<MUTEX>, "holder", 2048, &ctx, benchmarkPriority - 1, nullptr, xPortGetCoreID());
+
+  Statistic statistic;
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    const uint32_t start = GetCycleCount();
+    ACCESS::Lock(mutex);
+    statistic.Add(GetCycleCount() - start);
+    ACCESS::Unlock(mutex);
+  }
+
+  // Wait until the holder task has finished, before the mutex and the context go out of scope.
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  statistic.Print(primitive, "same_core", holdCycles);
+}
+
+// Runs on the other core: locks the mutex, hands the turn to the measured task and holds the mutex for holdCycles.
+template <typename MUTEX>
+void CrossCoreHolderTask(void* param)
+{
+  Context<MUTEX>& ctx = *static_cast<Context<MUTEX>*>(param);
+
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    while (ctx.turn.load() != (2 * round))
+    {
+    }
+
+    ctx.mutex.Lock();
+    ctx.turn.store((2 * round) + 1);
+    BusyWait(holdCycles);
+    ctx.mutex.Unlock();
+  }
+
+  xTaskNotifyGive(ctx.waiter);
+  vTaskDelete(nullptr);
+}
+
+template <typename MUTEX, typename ACCESS = ExclusiveAccess>
+void MeasureCrossCore(const char* primitive, MUTEX& mutex)
+{
+  Context<MUTEX> ctx {mutex, xTaskGetCurrentTaskHandle(), {0}};
+  const BaseType_t otherCore = (0 == xPortGetCoreID()) ? 1 : 0;
+  xTaskCreatePinnedToCore(CrossCoreHolderTask<MUTEX>, "holder", 2048, &ctx, benchmarkPriority, nullptr, otherCore);
+
+  Statistic statistic;
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    while (ctx.turn.load() != ((2 * round) + 1))
+    {
+    }
+
+    const uint32_t start = GetCycleCount();
+    ACCESS::Lock(mutex);
+    statistic.Add(GetCycleCount() - start);
+    ACCESS::Unlock(mutex);
+
+    ctx.turn.store((2 * round) + 2);
+  }
+
+  // Wait until the holder task has finished, before the mutex and the context go out of scope.
+  ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  statistic.Print(primitive, "cross_core", holdCycles);
+}
+
+template <typename MUTEX>
+void MeasureAll(const char* primitive, MUTEX& mutex)
+{
+  MeasureUncontendedPair(primitive, mutex);
+  MeasureSameCore(primitive, mutex);
+  MeasureCrossCore(primitive, mutex);
+}
+
+void MeasureMutexes()
+{
+  // The NullMutex is the baseline, i.e. the measurement overhead.
+  rtos::NullMutex nullMutex;
+  MeasureUncontendedPair("NullMutex", nullMutex);
+
+  rtos::Mutex mutex;
+  MeasureAll("Mutex", mutex);
+
+  rtos::Mutex adaptiveMutex {1000};
+  MeasureAll("Mutex_adaptive_1000", adaptiveMutex);
+
+  rtos::StaticMutex staticMutex;
+  MeasureAll("StaticMutex", staticMutex);
+
+  rtos::InlineMutex inlineMutex;
+  MeasureAll("InlineMutex", inlineMutex);
+
+  rtos::RecursiveMutex recursiveMutex;
+  MeasureAll("RecursiveMutex", recursiveMutex);
+  recursiveMutex.Lock();
+  MeasureUncontendedPair("RecursiveMutex_reentry", recursiveMutex);
+  recursiveMutex.Unlock();
+
+  rtos::RecursiveMutex cachedRecursiveMutex {rtos::RecursiveMutex::Recursion::OwnerCached};
+  MeasureAll("RecursiveMutex_cached", cachedRecursiveMutex);
+  cachedRecursiveMutex.Lock();
+  MeasureUncontendedPair("RecursiveMutex_cached_reentry", cachedRecursiveMutex);
+  cachedRecursiveMutex.Unlock();
+
+  rtos::StaticRecursiveMutex staticRecursiveMutex;
+  MeasureAll("StaticRecursiveMutex", staticRecursiveMutex);
+  staticRecursiveMutex.Lock();
+  MeasureUncontendedPair("StaticRecursiveMutex_reentry", staticRecursiveMutex);
+  staticRecursiveMutex.Unlock();
+
+  // The SpinLock disables the interrupts while locked, so it can not be contended on the same core.
+  rtos::SpinLock spinLock;
+  MeasureUncontendedPair("SpinLock", spinLock);
+  MeasureCrossCore("SpinLock", spinLock);
+
+  rtos::SharedMutex sharedMutex;
+  MeasureAll("SharedMutex", sharedMutex);
+  MeasureUncontended("SharedMutex_shared", "uncontended", [&sharedMutex]() {
+    sharedMutex.LockShared();
+    sharedMutex.UnlockShared();
+  });
+  MeasureSameCore<rtos::SharedMutex, SharedAccess>("SharedMutex_shared", sharedMutex);
+  MeasureCrossCore<rtos::SharedMutex, SharedAccess>("SharedMutex_shared", sharedMutex);
+}
+
+void MeasureGuards()
+{
+  rtos::Mutex mutex;
+  rtos::Mutex otherMutex;
+  rtos::SharedMutex sharedMutex;
+
+  MeasureUncontended("LockGuard<Mutex>", "uncontended", [&mutex]() {
+    rtos::LockGuard<rtos::Mutex> guard {mutex};
+  });
+  MeasureUncontended("LockGuard<Mutex>_tryToLock", "uncontended", [&mutex]() {
+    rtos::LockGuard<rtos::Mutex> guard {mutex, rtos::tryToLock};
+  });
+  MeasureUncontended("UniqueLock<Mutex>", "uncontended", [&mutex]() {
+    rtos::UniqueLock<rtos::Mutex> lock {mutex};
+  });
+  MeasureUncontended("ScopedLock<Mutex,Mutex>", "uncontended", [&mutex, &otherMutex]() {
+    rtos::ScopedLock<rtos::Mutex, rtos::Mutex> lock {mutex, otherMutex};
+  });
+  MeasureUncontended("SharedLockGuard<SharedMutex>", "uncontended", [&sharedMutex]() {
+    rtos::SharedLockGuard<rtos::SharedMutex> guard {sharedMutex};
+  });
+}
+
+struct Sample
+{
+  uint32_t values[8];
+};
+
+void MeasureLockFree()
+{
+  static rtos::SeqLock<Sample> seqLock;
+  MeasureUncontended("SeqLock<32B>_read", "uncontended", []() {
+    [[maybe_unused]] volatile uint32_t value = seqLock.Read().values[0];
+  });
+  MeasureUncontended("SeqLock<32B>_write", "uncontended", []() {
+    seqLock.Write(Sample{});
+  });
+
+  static rtos::TripleBuffer<Sample> tripleBuffer;
+  MeasureUncontended("TripleBuffer<32B>_read", "uncontended", []() {
+    [[maybe_unused]] volatile uint32_t value = tripleBuffer.Read()->values[0];
+  });
+  MeasureUncontended("TripleBuffer<32B>_publish", "uncontended", []() {
+    tripleBuffer.Publish();
+  });
+}
+
+} // namespace
+
+void RunLockBenchmark()
+{
+  // The holder tasks rely on a known priority of the measuring task.
+  const UBaseType_t priority = uxTaskPriorityGet(nullptr);
+  vTaskPrioritySet(nullptr, benchmarkPriority);
+
+  Serial.println("benchmark,primitive,case,hold_cycles,avg_cycles,min_cycles,max_cycles");
+  MeasureMutexes();
+  MeasureGuards();
+  MeasureLockFree();
+
+  vTaskPrioritySet(nullptr, priority);
+}
+
+} // namespace benchmark
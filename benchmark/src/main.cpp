@@ -0,0 +1,23 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <Arduino.h>
+
+#include "Benchmark.hpp"
+
+void setup()
+{
+  Serial.begin(115200);
+  delay(1000);
+
+  benchmark::RunLockBenchmark();
+  benchmark::RunAdaptiveMutexBenchmark();
+  benchmark::RunCoroutineBenchmark();
+}
+
+void loop()
+{
+  vTaskDelay(portMAX_DELAY);
+}
@@ -0,0 +1,200 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_0F163FAD49BD41928B5F6A6E7B0A22F1
+#define HEADER_0F163FAD49BD41928B5F6A6E7B0A22F1
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+#include <kernelapi/rtos/PoolPtr.hpp>
+#include <kernelapi/rtos/PoolStats.hpp>
+
+namespace rtos
+{
+
+// The layout depends on KERNELAPI_ENABLE_POOL_STATS, see PoolStats.hpp.
+inline namespace KERNELAPI_POOL_STATS_ABI
+{
+
+/**
+ * @brief The BlockPool class is a fixed-size memory pool for \a N objects of type T.
+ *        Allocate() and Free() are O(1) and lock-free: The free blocks are kept in a list, whose head is updated by compare-and-swap.
+ *        The head contains a tag, which is incremented on every update, so a concurrently reused block is detected (ABA problem).
+ *        Thus the pool does not serialize the cores like the global RTOS heap does, and it can be used within ISRs as well.
+ *
+ * @note The memory of the blocks is embedded in the BlockPool.
+ * @note The destructor of T runs in the context calling Free(), keep that in mind when freeing within an ISR.
+ * @note When KERNELAPI_ENABLE_POOL_STATS is defined, the pool records its usage and exhaustion counters, see PoolStats.hpp.
+ *       The macro changes the layout of the pool, define it for all code sharing a pool, or for none.
+ */
+template <typename T, size_t N>
+class BlockPool
+{
+  static_assert((0 < N) && (N < 0xFFFF), "The pool supports 1 to 65534 blocks");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "The pool needs lock-free atomics");
+
+  // Make this class non-copyable
+  public:
+  BlockPool(const BlockPool& other) = delete;
+  BlockPool& operator=(const BlockPool& other) = delete;
+
+  public:
+  /**
+   * The constructor links all blocks into the list of free blocks.
+   */
+  BlockPool() :
+    _head{Pack(0, 0)}
+#if defined(KERNELAPI_ENABLE_POOL_STATS)
+    , _poolStats{this, N}
+#endif
+  {
+    for (size_t index = 0; index < N; ++index)
+    {
+      _next[index].store(static_cast<uint16_t>(((index + 1) < N) ? (index + 1) : endOfList), std::memory_order_relaxed);
+    }
+  }
+
+  public:
+  /**
+   * @returns the number of blocks of the pool.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return N;
+  }
+
+  /**
+   * @brief Allocates a block and constructs an object of type T in it.
+   * @param[in] args The arguments for the constructor of T.
+   * @returns the object, nullptr if the pool is exhausted.
+   */
+  template <typename... ARGS>
+  T* Allocate(ARGS&&... args)
+  {
+    void* const block = AllocateBlock();
+    return (nullptr != block) ? new (block) T(std::forward<ARGS>(args)...) : nullptr;
+  }
+
+  /**
+   * @brief Destroys the object and returns its block to the pool.
+   * @param[in] object The object allocated from this pool, nullptr is ignored.
+   */
+  void Free(T* object)
+  {
+    if (nullptr != object)
+    {
+      assert(Owns(object) && "The object was not allocated from this pool");
+      object->~T();
+      FreeBlock(object);
+    }
+  }
+
+  /**
+   * @brief Allocates a block and constructs an object of type T in it, see Allocate().
+   * @returns the PoolPtr owning the object, empty if the pool is exhausted.
+   */
+  template <typename... ARGS>
+  PoolPtr<T> MakePooled(ARGS&&... args)
+  {
+    return PoolPtr<T>{Allocate(std::forward<ARGS>(args)...), this,
+                      [](void* pool, T* object) { static_cast<BlockPool*>(pool)->Free(object); }};
+  }
+
+  /**
+   * @returns true if the object lies within the memory of this pool.
+   */
+  bool Owns(const T* object) const
+  {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(object);
+    const uintptr_t begin = reinterpret_cast<uintptr_t>(&_blocks[0]);
+    return (address >= begin) && (address < (begin + sizeof(_blocks))) && (0 == ((address - begin) % sizeof(Block)));
+  }
+
+  private:
+  static constexpr uint16_t endOfList {0xFFFF};
+
+  // The head of the free list: The index of the first free block in the lower half, the tag in the upper half.
+  static constexpr uint32_t Pack(uint16_t index, uint16_t tag)
+  {
+    return (static_cast<uint32_t>(tag) << 16) | index;
+  }
+
+  static constexpr uint16_t IndexOf(uint32_t head)
+  {
+    return static_cast<uint16_t>(head & 0xFFFF);
+  }
+
+  static constexpr uint16_t TagOf(uint32_t head)
+  {
+    return static_cast<uint16_t>(head >> 16);
+  }
+
+  void* AllocateBlock()
+  {
+    uint32_t head = _head.load(std::memory_order_acquire);
+
+    while (true)
+    {
+      const uint16_t index = IndexOf(head);
+      if (endOfList == index)
+      {
+#if defined(KERNELAPI_ENABLE_POOL_STATS)
+        _poolStats.OnExhausted();
+#endif
+        return nullptr;
+      }
+
+      // The next index may be outdated, if the block was allocated concurrently. Then the tag has changed and the exchange fails.
+      const uint16_t next = _next[index].load(std::memory_order_relaxed);
+      if (_head.compare_exchange_weak(head, Pack(next, TagOf(head) + 1), std::memory_order_acq_rel, std::memory_order_acquire))
+      {
+#if defined(KERNELAPI_ENABLE_POOL_STATS)
+        _poolStats.OnAllocated();
+#endif
+        return &_blocks[index];
+      }
+    }
+  }
+
+  void FreeBlock(void* block)
+  {
+    const uint16_t index = static_cast<uint16_t>(static_cast<Block*>(block) - _blocks);
+    uint32_t head = _head.load(std::memory_order_relaxed);
+
+    do
+    {
+      _next[index].store(IndexOf(head), std::memory_order_relaxed);
+    }
+    while (!_head.compare_exchange_weak(head, Pack(index, TagOf(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+
+#if defined(KERNELAPI_ENABLE_POOL_STATS)
+    _poolStats.OnFreed();
+#endif
+  }
+
+  private:
+  struct Block
+  {
+    alignas(T) uint8_t data[sizeof(T)];
+  };
+
+  std::atomic<uint32_t> _head;           /** The index of the first free block and the tag. */
+  std::atomic<uint16_t> _next[N];        /** The index of the next free block for each free block. */
+  Block _blocks[N];                      /** The memory of the blocks. */
+#if defined(KERNELAPI_ENABLE_POOL_STATS)
+  rtos::PoolStatsRecord _poolStats;      /** The usage statistics of this pool. */
+#endif
+};
+
+} // namespace KERNELAPI_POOL_STATS_ABI
+
+} // namespace rtos
+
+#endif // HEADER_0F163FAD49BD41928B5F6A6E7B0A22F1
@@ -0,0 +1,304 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_FB9D74D45BA244FAB0F810E620EAD4BA
+#define HEADER_FB9D74D45BA244FAB0F810E620EAD4BA
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/CacheLine.hpp>
+#include <kernelapi/rtos/Span.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+namespace detail
+{
+
+/**
+ * @brief The ByteRing class is the lock-free single-writer/single-reader byte ring of the StreamBuffer and the MessageBuffer.
+ *        The writer and the reader access the bytes in place, the free-running head and tail indices are published with acquire/release atomics.
+ *        A blocked writer or reader task registers itself and is woken up by a task notification of the other side,
+ *        when the required number of bytes or spaces is available. If configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 the last notification
+ *        index is used, otherwise index 0. A notification is never left over, when a wait ends.
+ *
+ * @tparam N The capacity in bytes, must be a power of two.
+ */
+template <size_t N>
+class ByteRing
+{
+  static_assert((1 < N) && (0 == (N & (N - 1))), "The capacity N has to be a power of two");
+  static_assert(std::atomic<size_t>::is_always_lock_free, "The ring needs lock-free atomics");
+
+  // Make this class non-copyable
+  public:
+  ByteRing(const ByteRing& other) = delete;
+  ByteRing& operator=(const ByteRing& other) = delete;
+
+  public:
+  ByteRing() :
+    _head{0},
+    _tail{0},
+    _reader{nullptr},
+    _readerNeeds{0},
+    _writer{nullptr},
+    _writerNeeds{0},
+    _buffer{}
+  {}
+
+  public:
+  // The free-running index of the next byte to be written, only valid for the writer.
+  size_t GetHead() const
+  {
+    return _head.load(std::memory_order_relaxed);
+  }
+
+  // The free-running index of the next byte to be read, only valid for the reader.
+  size_t GetTail() const
+  {
+    return _tail.load(std::memory_order_relaxed);
+  }
+
+  uint8_t* At(size_t index)
+  {
+    return &_buffer[index & mask];
+  }
+
+  // Returns the number of contiguous bytes from \a index to the end of the ring.
+  static constexpr size_t GetContiguous(size_t index)
+  {
+    return N - (index & mask);
+  }
+
+  size_t GetBytesAvailable() const
+  {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  size_t GetSpacesAvailable() const
+  {
+    return N - GetBytesAvailable();
+  }
+
+  // Writer side: copies as many bytes as fit to the head, without committing them.
+  size_t CopyIn(const uint8_t* data, size_t size)
+  {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t space = N - (head - _tail.load(std::memory_order_acquire));
+    const size_t count = Min(size, space);
+    const size_t first = Min(count, GetContiguous(head));
+
+    std::memcpy(At(head), data, first);
+    std::memcpy(_buffer, data + first, count - first);
+    return count;
+  }
+
+  // Writer side: the free contiguous bytes at the head, at most \a count.
+  Span<uint8_t> Reserve(size_t count)
+  {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t space = N - (head - _tail.load(std::memory_order_acquire));
+    return Span<uint8_t>{At(head), Min(Min(count, space), GetContiguous(head))};
+  }
+
+  void Commit(size_t count)
+  {
+    _head.store(_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    if (TaskHandle_t reader = Waiting(_reader, _readerNeeds, GetBytesAvailable()); nullptr != reader)
+    {
+      Notify(reader);
+    }
+  }
+
+  void CommitFromISR(size_t count, BaseType_t* woken)
+  {
+    _head.store(_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    if (TaskHandle_t reader = Waiting(_reader, _readerNeeds, GetBytesAvailable()); nullptr != reader)
+    {
+      NotifyFromISR(reader, woken);
+    }
+  }
+
+  // Reader side: copies as many bytes as available from the tail, without consuming them.
+  size_t CopyOut(uint8_t* buffer, size_t size)
+  {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t available = _head.load(std::memory_order_acquire) - tail;
+    const size_t count = Min(size, available);
+    const size_t first = Min(count, GetContiguous(tail));
+
+    std::memcpy(buffer, At(tail), first);
+    std::memcpy(buffer + first, _buffer, count - first);
+    return count;
+  }
+
+  // Reader side: the available contiguous bytes at the tail, at most \a count.
+  Span<const uint8_t> Peek(size_t count)
+  {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t available = _head.load(std::memory_order_acquire) - tail;
+    return Span<const uint8_t>{At(tail), Min(Min(count, available), GetContiguous(tail))};
+  }
+
+  void Consume(size_t count)
+  {
+    _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    if (TaskHandle_t writer = Waiting(_writer, _writerNeeds, GetSpacesAvailable()); nullptr != writer)
+    {
+      Notify(writer);
+    }
+  }
+
+  void ConsumeFromISR(size_t count, BaseType_t* woken)
+  {
+    _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    if (TaskHandle_t writer = Waiting(_writer, _writerNeeds, GetSpacesAvailable()); nullptr != writer)
+    {
+      NotifyFromISR(writer, woken);
+    }
+  }
+
+  bool WaitForBytes(size_t count, rtos::Ticks_t timeout)
+  {
+    return Wait(_reader, _readerNeeds, count, timeout, [this]() { return GetBytesAvailable(); });
+  }
+
+  bool WaitForSpaces(size_t count, rtos::Ticks_t timeout)
+  {
+    return Wait(_writer, _writerNeeds, count, timeout, [this]() { return GetSpacesAvailable(); });
+  }
+
+  void Reset()
+  {
+    _head.store(0, std::memory_order_relaxed);
+    _tail.store(0, std::memory_order_release);
+  }
+
+  private:
+  static constexpr size_t mask {N - 1};
+
+  static constexpr size_t Min(size_t a, size_t b)
+  {
+    return (a < b) ? a : b;
+  }
+
+  // Use a dedicated notification index if available, so the ring does not interfere with other notifications.
+#if defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+  static constexpr UBaseType_t notifyIndex {configTASK_NOTIFICATION_ARRAY_ENTRIES - 1};
+
+  static void Notify(TaskHandle_t task)
+  {
+    xTaskNotifyGiveIndexed(task, notifyIndex);
+  }
+
+  static void NotifyFromISR(TaskHandle_t task, BaseType_t* woken)
+  {
+    vTaskNotifyGiveIndexedFromISR(task, notifyIndex, woken);
+  }
+
+  static bool TakeNotification(rtos::Ticks_t timeout)
+  {
+    return (0 != ulTaskNotifyTakeIndexed(notifyIndex, pdTRUE, timeout));
+  }
+#else
+  static void Notify(TaskHandle_t task)
+  {
+    xTaskNotifyGive(task);
+  }
+
+  static void NotifyFromISR(TaskHandle_t task, BaseType_t* woken)
+  {
+    vTaskNotifyGiveFromISR(task, woken);
+  }
+
+  static bool TakeNotification(rtos::Ticks_t timeout)
+  {
+    return (0 != ulTaskNotifyTake(pdTRUE, timeout));
+  }
+#endif
+
+  // Blocks the calling task until \a available() returns at least \a count or the timeout has been reached.
+  template <typename AVAILABLE>
+  static bool Wait(std::atomic<TaskHandle_t>& waiter, std::atomic<size_t>& needs, size_t count, rtos::Ticks_t timeout,
+                   AVAILABLE available)
+  {
+    if ((available() >= count) || (0 == timeout))
+    {
+      return (available() >= count);
+    }
+
+    TimeOut_t timeOutState;
+    TickType_t remaining {timeout};
+    vTaskSetTimeOutState(&timeOutState);
+    needs.store(count, std::memory_order_relaxed);
+
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (;;)
+    {
+      waiter.store(self, std::memory_order_release);
+
+      // Pairs with the fence in Waiting(), so either the other side sees the waiter or we see the new bytes or spaces.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if ((available() >= count) || !TakeNotification(remaining))
+      {
+        break;
+      }
+
+      // The other side has claimed the waiter. Check again, it may not have provided enough bytes or spaces.
+      if (pdTRUE == xTaskCheckForTimeOut(&timeOutState, &remaining))
+      {
+        return (available() >= count);
+      }
+    }
+
+    // The other side claimed the waiter concurrently, consume its notification, so it is not left over for the next wait.
+    if (nullptr == waiter.exchange(nullptr, std::memory_order_acq_rel))
+    {
+      // Use while loop in case infinite wait is not implemented by the rtos port.
+      while (!TakeNotification(GetMaxDelay()))
+      {
+      }
+    }
+
+    return (available() >= count);
+  }
+
+  // Returns the waiting task, if it needs no more than \a available bytes or spaces, and unregisters it.
+  static TaskHandle_t Waiting(std::atomic<TaskHandle_t>& waiter, const std::atomic<size_t>& needs, size_t available)
+  {
+    // Pairs with the fence in Wait().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if ((nullptr == waiter.load(std::memory_order_acquire)) || (available < needs.load(std::memory_order_relaxed)))
+    {
+      return nullptr;
+    }
+
+    return waiter.exchange(nullptr, std::memory_order_acq_rel);
+  }
+
+  private:
+  alignas(rtos::cacheLineSize) std::atomic<size_t> _head; /** The index of the next byte to be written, written by the writer. */
+  alignas(rtos::cacheLineSize) std::atomic<size_t> _tail; /** The index of the next byte to be read, written by the reader. */
+  std::atomic<TaskHandle_t> _reader;                      /** The reader task waiting for bytes, nullptr if none. */
+  std::atomic<size_t> _readerNeeds;                       /** The number of bytes the reader waits for. */
+  std::atomic<TaskHandle_t> _writer;                      /** The writer task waiting for spaces, nullptr if none. */
+  std::atomic<size_t> _writerNeeds;                       /** The number of spaces the writer waits for. */
+  alignas(rtos::cacheLineSize) uint8_t _buffer[N];        /** The bytes. */
+};
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_FB9D74D45BA244FAB0F810E620EAD4BA
@@ -0,0 +1,26 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_7796B372047E4C71BD68638E297C25D1
+#define HEADER_7796B372047E4C71BD68638E297C25D1
+
+#include <cstddef>
+
+// The cache line size can be overridden by defining KERNELAPI_CACHE_LINE_SIZE in the build flags.
+#if !defined(KERNELAPI_CACHE_LINE_SIZE)
+  #define KERNELAPI_CACHE_LINE_SIZE 64
+#endif
+
+namespace rtos
+{
+
+/**
+ * @brief The alignment, which keeps data written by different cores on separate cache lines (avoids false sharing).
+ */
+constexpr size_t cacheLineSize {KERNELAPI_CACHE_LINE_SIZE};
+
+} // namespace rtos
+
+#endif // HEADER_7796B372047E4C71BD68638E297C25D1
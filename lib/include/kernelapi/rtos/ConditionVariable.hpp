@@ -0,0 +1,184 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A2CB171968194E3A8408FE949B647920
+#define HEADER_A2CB171968194E3A8408FE949B647920
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/SpinLock.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The ConditionVariable class blocks one or more tasks until another task modifies a shared condition and notifies the ConditionVariable.
+ *        The condition is protected by a mutex, which is passed to the wait methods as lock, e.g. LockGuard<Mutex>, LockGuard<RecursiveMutex>
+ *        or UniqueLock<Mutex>. While waiting, the lock is released.
+ *
+ * @note Each waiting task enqueues a waiter on its own stack and is woken up by a direct to task notification, no memory is allocated.
+ *       The waiters are woken up in FIFO order.
+ *       If configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 the last notification index is used, otherwise index 0, do not use it for another
+ *       purpose in the waiting tasks.
+ *
+ * @note A RecursiveMutex must be locked exactly once by the waiting task, otherwise it is not released while waiting.
+ * @note As with the C++11 condition_variable, spurious wakeups are possible: Use the predicate versions of the wait methods.
+ * @note Do not call the methods within an ISR!
+ */
+class ConditionVariable
+{
+  // Make this class non-copyable
+  public:
+  ConditionVariable(const ConditionVariable& other) = delete;
+  ConditionVariable& operator=(const ConditionVariable& other) = delete;
+
+  public:
+  ConditionVariable();
+
+  public:
+  /**
+   * @brief Releases the lock, blocks until notified and locks again.
+   * @param[in,out] lock The owned lock protecting the condition.
+   */
+  template <typename LOCK>
+  void Wait(LOCK& lock)
+  {
+    // Use while loop in case infinite wait is not implemented by the rtos port.
+    while (!WaitFor(lock, GetMaxDelay()))
+    {
+    }
+  }
+
+  /**
+   * @brief Waits until the predicate is satisfied, see Wait().
+   * @param[in,out] lock The owned lock protecting the condition.
+   * @param[in] predicate Returns true if the condition is satisfied, it is only called while the lock is owned.
+   */
+  template <typename LOCK, typename PREDICATE>
+  void Wait(LOCK& lock, PREDICATE predicate)
+  {
+    while (!predicate())
+    {
+      Wait(lock);
+    }
+  }
+
+  /**
+   * @brief Releases the lock, blocks until notified or the timeout has been reached and locks again.
+   * @param[in,out] lock The owned lock protecting the condition.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if notified, false if the timeout has been reached.
+   */
+  template <typename LOCK>
+  bool WaitFor(LOCK& lock, rtos::Ticks_t timeout)
+  {
+    Waiter waiter {};
+    Enqueue(waiter);
+    lock.Unlock();
+    const bool notified = Block(waiter, timeout);
+    lock.Lock();
+    return notified;
+  }
+
+  /**
+   * @brief Waits until the predicate is satisfied or the timeout has been reached, see WaitFor().
+   * @param[in,out] lock The owned lock protecting the condition.
+   * @param[in] timeout maximum time to block until.
+   * @param[in] predicate Returns true if the condition is satisfied, it is only called while the lock is owned.
+   * @returns the result of the predicate.
+   */
+  template <typename LOCK, typename PREDICATE>
+  bool WaitFor(LOCK& lock, rtos::Ticks_t timeout, PREDICATE predicate)
+  {
+    TimeOut_t timeOutState;
+    TickType_t remaining {timeout};
+    vTaskSetTimeOutState(&timeOutState);
+
+    while (!predicate())
+    {
+      // Updates the remaining time, if woken up although the condition is not satisfied.
+      if (!WaitFor(lock, remaining) || (pdTRUE == xTaskCheckForTimeOut(&timeOutState, &remaining)))
+      {
+        return predicate();
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Releases the lock, blocks until notified or the timeout has been reached and locks again.
+   * @param[in,out] lock The owned lock protecting the condition.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if notified, false if the timeout has been reached.
+   */
+  template <typename LOCK, typename REP, typename PERIOD>
+  bool WaitFor(LOCK& lock, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return WaitFor(lock, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Waits until the predicate is satisfied or the timeout has been reached.
+   * @param[in,out] lock The owned lock protecting the condition.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @param[in] predicate Returns true if the condition is satisfied, it is only called while the lock is owned.
+   * @returns the result of the predicate.
+   */
+  template <typename LOCK, typename REP, typename PERIOD, typename PREDICATE>
+  bool WaitFor(LOCK& lock, const std::chrono::duration<REP, PERIOD>& timeout, PREDICATE predicate)
+  {
+    return WaitFor(lock, rtos::ToTicks(timeout), predicate);
+  }
+
+  /**
+   * @brief Wakes up the longest waiting task, if any.
+   */
+  void NotifyOne();
+
+  /**
+   * @brief Wakes up all waiting tasks.
+   */
+  void NotifyAll();
+
+  private:
+  /**
+   * @brief A waiting task, placed on the stack of the task.
+   */
+  struct Waiter
+  {
+    TaskHandle_t task; /** The waiting task. */
+    Waiter* next;      /** The next waiting task. */
+    bool notified;     /** Set by the notifying task before the task notification is given. */
+  };
+
+  /**
+   * @brief Appends the waiter of the calling task to the list of waiters.
+   */
+  void Enqueue(Waiter& waiter);
+
+  /**
+   * @brief Blocks until the waiter is notified or the timeout has been reached.
+   * A notification, which was not given by this condition variable, does not end the wait.
+   * @returns true if notified, false if the timeout has been reached.
+   */
+  bool Block(Waiter& waiter, rtos::Ticks_t timeout);
+
+  /**
+   * @brief Removes the waiter from the list of waiters, to be called while \a _lock is held.
+   */
+  void Unlink(Waiter& waiter);
+
+  private:
+  rtos::SpinLock _lock; /** Protects the list of waiters. */
+  Waiter* _head;        /** The longest waiting task. */
+  Waiter* _tail;        /** The most recently waiting task. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_A2CB171968194E3A8408FE949B647920
@@ -0,0 +1,534 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_D4522D0D20AC4B10878D792E174C99C0
+#define HEADER_D4522D0D20AC4B10878D792E174C99C0
+
+// The coroutines require C++20, the header is empty when compiled with an older standard, e.g. the default gnu++17.
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+  #define KERNELAPI_HAS_COROUTINES 1
+#endif
+
+#if defined(KERNELAPI_HAS_COROUTINES)
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <utility>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Queue.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+class Executor;
+
+namespace detail
+{
+
+/**
+ * @brief A suspended coroutine, which is resumed by the Executor as soon as poll() returns true.
+ *        The node is embedded in the awaiter, which lives in the coroutine frame while the coroutine is suspended.
+ */
+struct AwaitNode
+{
+  AwaitNode* next {nullptr};                /** The next suspended coroutine of the executor. */
+  std::coroutine_handle<> handle {};        /** The suspended coroutine. */
+  bool (*poll)(AwaitNode& node) {nullptr};  /** Returns true if the coroutine can continue. */
+  bool needsPolling {true};                 /** false if the executor is woken by Executor::Wake() instead of polling. */
+};
+
+} // namespace detail
+
+/**
+ * @brief The Coroutine class is the return type of a coroutine, which is run by an Executor.
+ *        The coroutine is suspended when called and starts when it is passed to Executor::Spawn().
+ *        The frame is freed when the coroutine returns.
+ *
+ * @note The frame is allocated from the RTOS heap. If the allocation fails, the Coroutine is not valid and Spawn() returns false.
+ * @note Only co_await the awaitables of this header within a Coroutine, e.g. LockAsync(), ReceiveAsync() or AsyncSignal::Wait().
+ *       A blocking call within a coroutine blocks all coroutines of the executor.
+ */
+class Coroutine
+{
+  public:
+  struct promise_type
+  {
+    Coroutine get_return_object() noexcept
+    {
+      return Coroutine{Handle::from_promise(*this)};
+    }
+
+    static Coroutine get_return_object_on_allocation_failure() noexcept
+    {
+      return Coroutine{nullptr};
+    }
+
+    std::suspend_always initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void return_void() noexcept
+    {}
+
+    void unhandled_exception() noexcept
+    {
+      std::terminate();
+    }
+
+    static void* operator new(size_t size) noexcept
+    {
+      return pvPortMalloc(size);
+    }
+
+    static void operator delete(void* frame) noexcept
+    {
+      vPortFree(frame);
+    }
+
+    detail::AwaitNode node {};      /** The node, which queues the spawned coroutine in the executor. */
+    Executor* executor {nullptr};   /** The executor, which runs the coroutine. */
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  // Make this class non-copyable
+  public:
+  Coroutine(const Coroutine& other) = delete;
+  Coroutine& operator=(const Coroutine& other) = delete;
+
+  public:
+  Coroutine(Coroutine&& other) noexcept :
+    _handle{std::exchange(other._handle, nullptr)}
+  {}
+
+  /**
+   * @brief Frees the frame of a coroutine, which was not spawned.
+   */
+  ~Coroutine()
+  {
+    if (_handle)
+    {
+      _handle.destroy();
+    }
+  }
+
+  public:
+  /**
+   * @returns true if the frame was allocated and the coroutine was not spawned yet.
+   */
+  bool IsValid() const
+  {
+    return static_cast<bool>(_handle);
+  }
+
+  private:
+  friend class Executor;
+
+  explicit Coroutine(Handle handle) :
+    _handle{handle}
+  {}
+
+  private:
+  Handle _handle; /** The coroutine, owned until it is spawned. */
+};
+
+/**
+ * @brief The Executor class runs many coroutines cooperatively within a single RTOS task, so they share one stack and one
+ *        task control block. A coroutine runs until it suspends at a co_await, then the executor resumes the next coroutine,
+ *        which can continue.
+ *        Waiting for a mutex, a queue or a delay is polled once every \a pollInterval ticks while the executor is idle,
+ *        an AsyncSignal wakes the executor immediately.
+ *
+ * @note The executor sleeps on the task notification (index 0) of its task, do not use it for another purpose.
+ * @note Spawn() may only be called before Run() or by a coroutine of this executor!
+ *
+ * Example:
+ * @code
+ * rtos::Coroutine Blink(rtos::AsyncSignal& signal) { for (;;) { co_await signal.Wait(); Toggle(); } }
+ *
+ * executor.Spawn(Blink(signal));
+ * task.Start(executor, &rtos::Executor::Run);
+ * @endcode
+ */
+class Executor
+{
+  // Make this class non-copyable
+  public:
+  Executor(const Executor& other) = delete;
+  Executor& operator=(const Executor& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] pollInterval The time between polling the waiting coroutines while the executor is idle.
+   */
+  explicit Executor(rtos::Ticks_t pollInterval = 1);
+
+  /**
+   * @brief Destroys the coroutines, which are still waiting or ready to run, and frees their frames.
+   * @note Must not be called while another task runs the executor. The coroutines are destroyed within the calling task,
+   *       the destructors of their locals run, e.g. a LockGuard unlocks its mutex. Do not signal an AsyncSignal of this executor afterwards.
+   */
+  ~Executor();
+
+  public:
+  /**
+   * @brief Queues the coroutine to be started by the executor.
+   * @param[in] coroutine The coroutine, the executor takes the ownership.
+   * @returns true if queued, false if the frame of the coroutine could not be allocated.
+   */
+  bool Spawn(Coroutine&& coroutine);
+
+  /**
+   * @brief Runs the coroutines within the calling task, does not return.
+   * Blocks on the task notification while no coroutine can continue.
+   */
+  void Run();
+
+  /**
+   * @brief Resumes every coroutine, which can continue, once. To be called by the task running the executor.
+   * @returns true if at least one coroutine was resumed.
+   */
+  bool RunOnce();
+
+  /**
+   * @brief Wakes up the executor, if it is idle.
+   */
+  void Wake();
+
+  /**
+   * @brief Wakes up the executor from within an ISR.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if the wakeup unblocked a task of higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   */
+  void WakeFromISR(BaseType_t* higherPriorityTaskWoken = nullptr);
+
+  /**
+   * @returns the number of coroutines, which are waiting or ready to run.
+   */
+  size_t GetCount() const;
+
+  /**
+   * @returns the task running the executor, nullptr if Run() was not called yet.
+   */
+  TaskHandle_t GetTaskHandle() const;
+
+  /**
+   * @brief Suspends the coroutine until the poll function of \a node returns true, to be called by await_suspend() of an awaitable.
+   * @param[in] node The node, embedded in the awaiter.
+   * @param[in] handle The suspended coroutine.
+   */
+  static void Suspend(detail::AwaitNode& node, Coroutine::Handle handle);
+
+  private:
+  void Append(detail::AwaitNode& node);
+
+  private:
+  const rtos::Ticks_t _pollInterval;  /** The time between polling while the executor is idle. */
+  detail::AwaitNode* _head;           /** The first waiting coroutine. */
+  detail::AwaitNode* _tail;           /** The last waiting coroutine. */
+  size_t _count;                      /** The number of waiting coroutines. */
+  size_t _polling;                    /** The number of waiting coroutines, which have to be polled. */
+  std::atomic<TaskHandle_t> _task;    /** The task running the executor. */
+};
+
+/**
+ * @brief The awaiter of LockAsync().
+ */
+template <typename MUTEX>
+class LockAwaiter : private detail::AwaitNode
+{
+  public:
+  explicit LockAwaiter(MUTEX& mutex) :
+    _mutex{mutex}
+  {}
+
+  bool await_ready()
+  {
+    return _mutex.TryLock();
+  }
+
+  void await_suspend(Coroutine::Handle handle)
+  {
+    poll = &LockAwaiter::Poll;
+    Executor::Suspend(*this, handle);
+  }
+
+  void await_resume() noexcept
+  {}
+
+  private:
+  static bool Poll(detail::AwaitNode& node)
+  {
+    return static_cast<LockAwaiter&>(node)._mutex.TryLock();
+  }
+
+  private:
+  MUTEX& _mutex; /** The mutex to be locked. */
+};
+
+/**
+ * @brief Locks the mutex without blocking the executor, e.g. co_await rtos::LockAsync(mutex).
+ *        The coroutine is suspended until the mutex is available, unlock it by calling Unlock().
+ *
+ * @note The lock is owned by the task running the executor, so a non-recursive mutex like Mutex or StaticMutex
+ *       is required to exclude the other coroutines of the executor. It has to be unlocked by the same coroutine.
+ *
+ * @param[in] mutex The mutex to be locked.
+ */
+template <typename MUTEX>
+LockAwaiter<MUTEX> LockAsync(MUTEX& mutex)
+{
+  return LockAwaiter<MUTEX>{mutex};
+}
+
+/**
+ * @brief The awaiter of ReceiveAsync().
+ */
+template <typename T, size_t N>
+class ReceiveAwaiter : private detail::AwaitNode
+{
+  public:
+  explicit ReceiveAwaiter(Queue<T, N>& queue) :
+    _queue{queue},
+    _item{}
+  {}
+
+  bool await_ready()
+  {
+    return _queue.Receive(_item, 0);
+  }
+
+  void await_suspend(Coroutine::Handle handle)
+  {
+    poll = &ReceiveAwaiter::Poll;
+    Executor::Suspend(*this, handle);
+  }
+
+  T await_resume() noexcept
+  {
+    return _item;
+  }
+
+  private:
+  static bool Poll(detail::AwaitNode& node)
+  {
+    ReceiveAwaiter& awaiter = static_cast<ReceiveAwaiter&>(node);
+    return awaiter._queue.Receive(awaiter._item, 0);
+  }
+
+  private:
+  Queue<T, N>& _queue;  /** The queue to receive from. */
+  T _item;              /** The received item. */
+};
+
+/**
+ * @brief Receives the item from the front of the queue without blocking the executor, e.g. T item = co_await rtos::ReceiveAsync(queue).
+ *        The coroutine is suspended until the queue contains an item.
+ * @param[in] queue The queue to receive from.
+ */
+template <typename T, size_t N>
+ReceiveAwaiter<T, N> ReceiveAsync(Queue<T, N>& queue)
+{
+  return ReceiveAwaiter<T, N>{queue};
+}
+
+/**
+ * @brief The awaiter of DelayAsync() and YieldAsync().
+ */
+class DelayAwaiter : private detail::AwaitNode
+{
+  public:
+  explicit DelayAwaiter(rtos::Ticks_t ticks) :
+    _start{0},
+    _ticks{ticks}
+  {}
+
+  bool await_ready() const noexcept
+  {
+    return false;
+  }
+
+  void await_suspend(Coroutine::Handle handle)
+  {
+    _start = xTaskGetTickCount();
+    poll = &DelayAwaiter::Poll;
+    Executor::Suspend(*this, handle);
+  }
+
+  void await_resume() noexcept
+  {}
+
+  private:
+  static bool Poll(detail::AwaitNode& node)
+  {
+    const DelayAwaiter& awaiter = static_cast<DelayAwaiter&>(node);
+    return ((xTaskGetTickCount() - awaiter._start) >= awaiter._ticks);
+  }
+
+  private:
+  TickType_t _start;      /** The tick count, when the coroutine was suspended. */
+  rtos::Ticks_t _ticks;   /** The delay. */
+};
+
+/**
+ * @brief Suspends the coroutine for at least \a ticks without blocking the executor, e.g. co_await rtos::DelayAsync(10).
+ *        The delay is extended to the next poll of the executor.
+ * @param[in] ticks The delay.
+ */
+inline DelayAwaiter DelayAsync(rtos::Ticks_t ticks)
+{
+  return DelayAwaiter{ticks};
+}
+
+/**
+ * @brief Suspends the coroutine for at least \a delay without blocking the executor.
+ * @param[in] delay The delay, rounded up to the next tick.
+ */
+template <typename REP, typename PERIOD>
+DelayAwaiter DelayAsync(const std::chrono::duration<REP, PERIOD>& delay)
+{
+  return DelayAwaiter{rtos::ToTicks(delay)};
+}
+
+/**
+ * @brief Lets the other coroutines of the executor run, e.g. co_await rtos::YieldAsync().
+ */
+inline DelayAwaiter YieldAsync()
+{
+  return DelayAwaiter{0};
+}
+
+/**
+ * @brief The AsyncSignal class is a binary event, which is awaited by a coroutine, e.g. co_await signal.Wait().
+ *        It is the counterpart of the NotifySignal for coroutines: Signalling wakes the executor of the waiting coroutine immediately,
+ *        so waiting for it is not polled. Signalling it several times before the coroutine waits results in a single wakeup.
+ *
+ * @note Only one coroutine may wait for the signal at a time. Use SignalFromISR() within an ISR.
+ */
+class AsyncSignal
+{
+  // Make this class non-copyable
+  public:
+  AsyncSignal(const AsyncSignal& other) = delete;
+  AsyncSignal& operator=(const AsyncSignal& other) = delete;
+
+  public:
+  /**
+   * @brief The awaiter of Wait().
+   */
+  class Awaiter : private detail::AwaitNode
+  {
+    public:
+    explicit Awaiter(AsyncSignal& signal) :
+      _signal{signal}
+    {}
+
+    bool await_ready()
+    {
+      return _signal.TryTake();
+    }
+
+    void await_suspend(Coroutine::Handle handle)
+    {
+      // Pairs with Signal(): Either Signal() sees the executor and wakes it or the executor polls the signal once more.
+      _signal._executor.store(handle.promise().executor);
+      poll = &Awaiter::Poll;
+      needsPolling = false;
+      Executor::Suspend(*this, handle);
+    }
+
+    void await_resume() noexcept
+    {}
+
+    private:
+    static bool Poll(detail::AwaitNode& node)
+    {
+      return static_cast<Awaiter&>(node)._signal.TryTake();
+    }
+
+    private:
+    AsyncSignal& _signal; /** The awaited signal. */
+  };
+
+  public:
+  AsyncSignal() :
+    _signaled{false},
+    _executor{nullptr}
+  {}
+
+  public:
+  /**
+   * @brief Sets the signal and wakes the executor of the waiting coroutine.
+   */
+  void Signal()
+  {
+    _signaled.store(true);
+    Executor* const executor = _executor.load();
+    if (nullptr != executor)
+    {
+      executor->Wake();
+    }
+  }
+
+  /**
+   * @brief Sets the signal from within an ISR.
+   * @param[out] higherPriorityTaskWoken See Executor::WakeFromISR().
+   */
+  void SignalFromISR(BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    _signaled.store(true);
+    Executor* const executor = _executor.load();
+    if (nullptr != executor)
+    {
+      executor->WakeFromISR(higherPriorityTaskWoken);
+    }
+  }
+
+  /**
+   * @returns true if the signal is set.
+   */
+  bool IsSignaled() const
+  {
+    return _signaled.load();
+  }
+
+  /**
+   * @returns the awaitable, which suspends the coroutine until the signal is set and clears it.
+   */
+  Awaiter Wait()
+  {
+    return Awaiter{*this};
+  }
+
+  private:
+  bool TryTake()
+  {
+    return _signaled.exchange(false);
+  }
+
+  private:
+  std::atomic<bool> _signaled;          /** true if the signal is set. */
+  std::atomic<Executor*> _executor;     /** The executor of the last waiting coroutine. */
+};
+
+} // namespace rtos
+
+#endif // KERNELAPI_HAS_COROUTINES
+
+#endif // HEADER_D4522D0D20AC4B10878D792E174C99C0
@@ -0,0 +1,182 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_395DEA21DB894173A32CD88F77C5A0A1
+#define HEADER_395DEA21DB894173A32CD88F77C5A0A1
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The EventGroup class holds a set of event bits, several tasks can wait for any or all of a combination of them.
+ *        Setting bits is a single kernel call, which unblocks every task whose condition is met,
+ *        instead of giving one semaphore per condition and waiter.
+ *        The memory of the native event group is embedded in the EventGroup, no memory is allocated from the RTOS heap.
+ *
+ * @note The EventGroup class is a wrapper class for the native RTOS event group implementation.
+ *       See https://www.freertos.org/xEventGroupCreateStatic.html for details.
+ *       Requires configSUPPORT_STATIC_ALLOCATION to be enabled in the RTOS configuration.
+ *
+ * @note The upper 8 bits of EventBits_t are reserved by the kernel, only the bits of GetUsableBits() may be used.
+ *       Each method taking bits asserts it.
+ * @note Use the FromISR methods when called within an ISR.
+ */
+class EventGroup
+{
+  // Make this class non-copyable
+  public:
+  EventGroup(const EventGroup& other) = delete;
+  EventGroup& operator=(const EventGroup& other) = delete;
+
+  public:
+  /**
+   * The default constructor.
+   * Creates the native RTOS event group within the embedded storage and stores the handle to it, all bits are cleared.
+   */
+  EventGroup();
+
+  /**
+   * @brief Destroy the event group handle, the waiting tasks are unblocked.
+   */
+  ~EventGroup();
+
+  public:
+  /**
+   * @returns true if the event group was created successfully, false otherwise.
+   */
+  bool IsValid() const;
+
+  /**
+   * @returns the mask of the bits, which can be used.
+   */
+  static constexpr EventBits_t GetUsableBits()
+  {
+    return (static_cast<EventBits_t>(~static_cast<EventBits_t>(0)) >> 8);
+  }
+
+  /**
+   * @brief Sets the bits and unblocks all tasks waiting for them.
+   * @param[in] bits The bits to be set.
+   * @returns the bits when the call returns, the bits may already be cleared by an unblocked task.
+   */
+  EventBits_t Set(EventBits_t bits);
+
+  /**
+   * @brief Sets the bits from within an ISR.
+   * The kernel defers the call to the timer daemon task, thus the waiting tasks are unblocked after the ISR.
+   * @param[in] bits The bits to be set.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if the timer daemon task has a higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns true if the request was passed to the timer daemon task, false if its command queue is full.
+   * @note Requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be enabled in the RTOS configuration.
+   */
+  bool SetFromISR(EventBits_t bits, BaseType_t* higherPriorityTaskWoken = nullptr);
+
+  /**
+   * @brief Clears the bits.
+   * @param[in] bits The bits to be cleared.
+   * @returns the bits before they were cleared.
+   */
+  EventBits_t Clear(EventBits_t bits);
+
+  /**
+   * @brief Clears the bits from within an ISR, the call is deferred to the timer daemon task.
+   * @param[in] bits The bits to be cleared.
+   * @returns true if the request was passed to the timer daemon task, false if its command queue is full.
+   */
+  bool ClearFromISR(EventBits_t bits);
+
+  /**
+   * @returns the current bits.
+   */
+  EventBits_t Get() const;
+
+  /**
+   * @returns the current bits, to be called within an ISR.
+   */
+  EventBits_t GetFromISR() const;
+
+  /**
+   * @brief Waits until at least one of the bits is set.
+   * If none of the bits is set, it blocks until specified timeout has been reached.
+   * @param[in] bits The bits to wait for.
+   * @param[in] timeout maximum time to block until.
+   * @param[in] clearOnExit If true, the awaited bits are cleared when the wait succeeds.
+   * @returns the awaited bits, which have been set, 0 if the timeout has been reached.
+   */
+  EventBits_t WaitAny(EventBits_t bits, rtos::Ticks_t timeout = GetMaxDelay(), bool clearOnExit = true);
+
+  /**
+   * @brief Waits until at least one of the bits is set.
+   * @param[in] bits The bits to wait for.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @param[in] clearOnExit If true, the awaited bits are cleared when the wait succeeds.
+   * @returns the awaited bits, which have been set, 0 if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  EventBits_t WaitAny(EventBits_t bits, const std::chrono::duration<REP, PERIOD>& timeout, bool clearOnExit = true)
+  {
+    return WaitAny(bits, rtos::ToTicks(timeout), clearOnExit);
+  }
+
+  /**
+   * @brief Waits until all of the bits are set.
+   * If not all of the bits are set, it blocks until specified timeout has been reached.
+   * @param[in] bits The bits to wait for.
+   * @param[in] timeout maximum time to block until.
+   * @param[in] clearOnExit If true, the awaited bits are cleared when the wait succeeds.
+   * @returns true if all bits have been set, false if the timeout has been reached.
+   */
+  bool WaitAll(EventBits_t bits, rtos::Ticks_t timeout = GetMaxDelay(), bool clearOnExit = true);
+
+  /**
+   * @brief Waits until all of the bits are set.
+   * @param[in] bits The bits to wait for.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @param[in] clearOnExit If true, the awaited bits are cleared when the wait succeeds.
+   * @returns true if all bits have been set, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool WaitAll(EventBits_t bits, const std::chrono::duration<REP, PERIOD>& timeout, bool clearOnExit = true)
+  {
+    return WaitAll(bits, rtos::ToTicks(timeout), clearOnExit);
+  }
+
+  /**
+   * @brief Rendezvous of several tasks: Sets the bits of the calling task and waits until the bits of all tasks are set.
+   * Then the awaited bits are cleared, in a single atomic kernel call, so no task misses the rendezvous.
+   * @param[in] setBits The bits of the calling task, to be set.
+   * @param[in] waitBits The bits of all tasks, including \a setBits.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if all tasks met, false if the timeout has been reached.
+   */
+  bool Sync(EventBits_t setBits, EventBits_t waitBits, rtos::Ticks_t timeout = GetMaxDelay());
+
+  /**
+   * @brief Rendezvous of several tasks, see Sync().
+   * @param[in] setBits The bits of the calling task, to be set.
+   * @param[in] waitBits The bits of all tasks, including \a setBits.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if all tasks met, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool Sync(EventBits_t setBits, EventBits_t waitBits, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Sync(setBits, waitBits, rtos::ToTicks(timeout));
+  }
+
+  private:
+  StaticEventGroup_t _storage;  /** The memory of the native event group. */
+  EventGroupHandle_t _handle;   /** The native event group handle managed by an instance of this class. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_395DEA21DB894173A32CD88F77C5A0A1
@@ -0,0 +1,136 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A1CAC77CBE6E414CA7D5F66AE5557266
+#define HEADER_A1CAC77CBE6E414CA7D5F66AE5557266
+
+#include <cassert>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The InlineMutex class is a header-only variant of the Mutex class.
+ *        All methods are defined inline and the class has no virtual methods, thus an instance only holds the native handle
+ *        and the calls of TryLockFor() and Unlock() can be inlined directly into xSemaphoreTake() and xSemaphoreGive().
+ *        The InlineMutex includes a priority inheritance mechanism for eliminating unbounded priority inversion.
+ *
+ * @note Use the InlineMutex in hot paths, e.g. together with LockGuard<InlineMutex>.
+ *       The InlineMutex is final and must not be used polymorphically.
+ *
+ * @note  This InlineMutex class is non-recursive, see Mutex for details.
+ *
+ * @note Do not call the mutex methods within an ISR!
+ */
+class InlineMutex final
+{
+  // Make this class non-copyable
+  public:
+  InlineMutex(const InlineMutex& other) = delete;
+  InlineMutex& operator=(const InlineMutex& other) = delete;
+
+  public:
+  /**
+   * The default constructor.
+   * Creates the native RTOS mutex and stores the handle to it.
+   * @note Call IsValid() to verify if the mutex was created successfully.
+   */
+  InlineMutex() :
+    _handle{xSemaphoreCreateMutex()}
+  {
+    assert(_handle && "Failed to create the mutex");
+  }
+
+  /**
+   * @brief Destroy the mutex handle.
+   */
+  ~InlineMutex()
+  {
+    vSemaphoreDelete(_handle);
+  }
+
+  public:
+  /**
+   * @returns true if the mutex was created successfully, false otherwise.
+   */
+  bool IsValid() const
+  {
+    return (nullptr != _handle);
+  }
+
+  /**
+   * @brief Locks the mutex.
+   * Blocks until mutex is available.
+   * @note This method has no timeout, it waits until the mutex is available.
+   */
+  void Lock()
+  {
+    // Use while loop in case infinite wait is not implemented by the rtos port.
+    while (!TryLockFor(GetMaxDelay()))
+    {
+    }
+  }
+
+  /**
+   * @brief Tries to lock the mutex, does not block if the mutex is not available.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLock()
+  {
+    return TryLockFor(0);
+  }
+
+  /**
+   * @brief Tries to lock the mutex.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  bool TryLockFor(rtos::Ticks_t timeout)
+  {
+    return (pdTRUE == xSemaphoreTake(_handle, timeout));
+  }
+
+  /**
+   * @brief Tries to lock the mutex.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Unlocks the mutex.
+   */
+  void Unlock()
+  {
+    [[maybe_unused]] const BaseType_t ret = xSemaphoreGive(_handle);
+  }
+
+  /**
+   * @returns true when the mutex is locked
+   */
+  bool IsLocked()
+  {
+    // If not locked, xSemaphoreGetMutexHolder returns NULL
+    return (nullptr != xSemaphoreGetMutexHolder(_handle));
+  }
+
+  private:
+  SemaphoreHandle_t _handle; /** The native mutex handle managed by an instance of this class. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_A1CAC77CBE6E414CA7D5F66AE5557266
@@ -0,0 +1,39 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_D09B172919654768849552EA863CF4D3
+#define HEADER_D09B172919654768849552EA863CF4D3
+
+#include <freertos/FreeRTOS.h>
+
+namespace rtos
+{
+
+namespace detail
+{
+
+/**
+ * @brief Passes the result of a FromISR kernel call to the caller or yields at the end of the ISR.
+ * @param[in] woken The higherPriorityTaskWoken result of the kernel call.
+ * @param[out] higherPriorityTaskWoken If not nullptr, \a woken is accumulated into it and the caller is responsible to yield.
+ *             If nullptr, it yields itself if required.
+ */
+inline void YieldFromISR(BaseType_t woken, BaseType_t* higherPriorityTaskWoken)
+{
+  if (nullptr != higherPriorityTaskWoken)
+  {
+    *higherPriorityTaskWoken |= woken;
+  }
+  else
+  {
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_D09B172919654768849552EA863CF4D3
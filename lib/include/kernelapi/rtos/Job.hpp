@@ -0,0 +1,87 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_8FD4ABCEAFE74602ADE3D2664F218BCD
+#define HEADER_8FD4ABCEAFE74602ADE3D2664F218BCD
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace rtos
+{
+
+/**
+ * @brief The Job class holds a function, lambda or function object to be called later, e.g. by a ThreadPool.
+ *        The callable is copied into a buffer of \a BYTES within the Job, so creating a Job never allocates memory.
+ *        The callable has to be trivially copyable, thus the Job can be copied byte-wise, e.g. through a Queue.
+ *
+ * @tparam BYTES The size of the buffer for the callable, large enough for a lambda capturing a few pointers.
+ */
+template <size_t BYTES = 4 * sizeof(void*)>
+class Job
+{
+  public:
+  /**
+   * The default constructor creates an empty job.
+   */
+  Job() :
+    _invoke{nullptr},
+    _storage{}
+  {}
+
+  /**
+   * The constructor copies the callable into the Job.
+   * @param[in] callable The function, function object or lambda to be called.
+   */
+  template <typename CALLABLE, typename = std::enable_if_t<!std::is_same_v<std::decay_t<CALLABLE>, Job>>>
+  Job(CALLABLE&& callable) :
+    _invoke{nullptr},
+    _storage{}
+  {
+    using Callable = std::decay_t<CALLABLE>;
+    static_assert(sizeof(Callable) <= BYTES, "The callable is too large, increase BYTES");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t), "The callable is over-aligned");
+    static_assert(std::is_trivially_copyable_v<Callable>, "The callable has to be trivially copyable");
+
+    new (_storage) Callable(std::forward<CALLABLE>(callable));
+    _invoke = [](void* storage) { (*static_cast<Callable*>(storage))(); };
+  }
+
+  public:
+  /**
+   * @brief Calls the callable, the job must not be empty.
+   */
+  void operator()()
+  {
+    _invoke(_storage);
+  }
+
+  /**
+   * @returns true if the job holds a callable.
+   */
+  bool IsValid() const
+  {
+    return (nullptr != _invoke);
+  }
+
+  /**
+   * @returns the size of the buffer for the callable in bytes.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return BYTES;
+  }
+
+  private:
+  void (*_invoke)(void*);                                 /** Calls the callable, nullptr if the job is empty. */
+  alignas(std::max_align_t) uint8_t _storage[BYTES];      /** The copy of the callable. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_8FD4ABCEAFE74602ADE3D2664F218BCD
@@ -0,0 +1,23 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_DE8EF47389CD434FB447F6533DACED63
+#define HEADER_DE8EF47389CD434FB447F6533DACED63
+
+namespace rtos
+{
+
+/**
+ * @brief The LazyCreate tag selects the constructor of a Mutex or RecursiveMutex, which defers creating the native RTOS mutex
+ *        until the mutex is locked for the first time.
+ *        This shortens the static initialization and saves the RTOS heap for mutexes, which are never used in a configuration.
+ */
+struct LazyCreate {};
+
+constexpr LazyCreate lazyCreate = {};
+
+} // namespace rtos
+
+#endif // HEADER_DE8EF47389CD434FB447F6533DACED63
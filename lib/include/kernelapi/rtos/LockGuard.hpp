@@ -6,6 +6,7 @@
 #ifndef HEADER_3D994825025C4BFB87A874447C3B6B84
 #define HEADER_3D994825025C4BFB87A874447C3B6B84
 
+#include <kernelapi/rtos/MutexTraits.hpp>
 #include <kernelapi/rtos/Ticks.hpp>
 
 namespace rtos
@@ -28,6 +29,8 @@ constexpr TryToLock tryToLock = {};
 template <typename MUTEX>
 class LockGuard
 {
+  static_assert(rtos::isLockable<MUTEX>, "MUTEX has to provide Lock(), TryLock() and Unlock(), see MutexTraits.hpp");
+
   // Make this class non-copyable
   public:
   LockGuard(const LockGuard& other) = delete;
@@ -81,6 +84,18 @@ class LockGuard
     TryLockFor(timeout);
   }
 
+  /**
+   * Stores the reference to the given mutex and tries to lock it.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @param[in] timeout maximum duration to block for, rounded up to the next tick.
+   * @note To verify the mutex was locked, call OwnsLock()
+   */
+  template <typename REP, typename PERIOD>
+  LockGuard(MUTEX& mutex, const std::chrono::duration<REP, PERIOD>& timeout) :
+    LockGuard(mutex, rtos::ToTicks(timeout))
+  {}
+
 	/**
 	 * Unlocks the mutex, when it owns the lock.
 	*/
@@ -131,6 +146,18 @@ class LockGuard
 		return _isLocked;
 	}
 
+	/**
+	 * Tries to lock the mutex.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] timeout maximum duration to block for, rounded up to the next tick.
+	 * @returns true, if it owns the lock, false otherwise.
+	 */
+	template <typename REP, typename PERIOD>
+	bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+	{
+		return TryLockFor(rtos::ToTicks(timeout));
+	}
+
 	/**
 	 * Unlock the mutex, if it was locked before.
 	 */
@@ -0,0 +1,179 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_E60BF82E9A6D43EFB6D5D476C42C7B3C
+#define HEADER_E60BF82E9A6D43EFB6D5D476C42C7B3C
+
+#include <atomic>
+#include <cstdint>
+
+// The lock statistics and the lock watchdog report FreeRTOS tasks and priorities, so the host backend does not support them.
+// Their sources are tested on the kernel emulation of the host tests instead.
+#if defined(KERNELAPI_BACKEND_HOST)
+  #if defined(KERNELAPI_ENABLE_LOCK_STATS)
+    #error "The lock statistics are not supported by the host backend"
+  #endif
+#else
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+// The time base of the lock statistics can be overridden by defining KERNELAPI_LOCK_STATS_TIMESTAMP() in the build flags.
+// By default the cpu cycle counter is used on ESP-IDF >= 5, the tick count otherwise and the steady clock by the host backend.
+#if !defined(KERNELAPI_LOCK_STATS_TIMESTAMP)
+  #if defined(ESP_PLATFORM)
+    #include <esp_idf_version.h>
+  #endif
+  #if defined(KERNELAPI_BACKEND_HOST)
+    #include <chrono>
+    #define KERNELAPI_LOCK_STATS_TIMESTAMP() std::chrono::steady_clock::now().time_since_epoch().count()
+  #elif defined(ESP_IDF_VERSION_MAJOR) && (ESP_IDF_VERSION_MAJOR >= 5)
+    #include <esp_cpu.h>
+    #define KERNELAPI_LOCK_STATS_TIMESTAMP() esp_cpu_get_cycle_count()
+  #else
+    #define KERNELAPI_LOCK_STATS_TIMESTAMP() xTaskGetTickCount()
+  #endif
+#endif
+
+// KERNELAPI_ENABLE_LOCK_STATS changes the layout of the locks, which embed a LockStatsRecord, so it is an ABI-affecting option:
+// Define it for the library and all code using it, or for none. The locks are declared within an inline namespace named after it,
+// thus code built with a different setting than the library fails to link, instead of silently violating the one definition rule.
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  #define KERNELAPI_LOCK_STATS_ABI lock_stats
+#else
+  #define KERNELAPI_LOCK_STATS_ABI no_lock_stats
+#endif
+
+namespace rtos
+{
+
+namespace detail
+{
+template <typename RECORD, typename STATS>
+class StatsRegistry;
+} // namespace detail
+
+/**
+ * @brief The statistics of a single lock.
+ *        All times are given in the time base of KERNELAPI_LOCK_STATS_TIMESTAMP(), by default in cpu cycles.
+ */
+struct LockStats
+{
+  const void* lock;         /** The address of the lock object. */
+  uint32_t acquisitions;    /** The number of successful acquisitions. */
+  uint32_t contentions;     /** The number of acquisitions, which had to wait because the lock was held. */
+  uint64_t totalWaitTime;   /** The accumulated time spent waiting in contended acquisitions. */
+  uint32_t maxWaitTime;     /** The longest time spent waiting in a single acquisition. */
+  uint32_t maxHoldTime;     /** The longest time the lock was held, measured from the outermost acquisition to the final release. */
+};
+
+/**
+ * @returns the current timestamp in the time base of the lock statistics.
+ */
+inline uint32_t GetLockStatsTimestamp()
+{
+  return static_cast<uint32_t>(KERNELAPI_LOCK_STATS_TIMESTAMP());
+}
+
+/**
+ * @brief The LockStatsRecord class records the statistics of a single lock and registers them in the global list of lock statistics.
+ *        A lock embeds a LockStatsRecord only when KERNELAPI_ENABLE_LOCK_STATS is defined, otherwise the instrumentation
+ *        has no cost at all. The macro changes the layout of the locks, see KERNELAPI_LOCK_STATS_ABI.
+ *
+ * @note OnAcquired() and OnReleased() must only be called by the task owning the lock, which serializes them.
+ *       The counters are atomic, as GetLockStats() and ResetLockStats() access them concurrently from any task.
+ *       Targets without 64 bit atomics, e.g. the ESP32, update the total wait time in a short critical section of the runtime library.
+ * @note The cycle counters of the cores are not synchronized, hold times of tasks migrating between the cores are inaccurate.
+ *       Pin the tasks or use a global time base for KERNELAPI_LOCK_STATS_TIMESTAMP().
+ */
+class LockStatsRecord
+{
+  // Make this class non-copyable
+  public:
+  LockStatsRecord(const LockStatsRecord& other) = delete;
+  LockStatsRecord& operator=(const LockStatsRecord& other) = delete;
+
+  public:
+  /**
+   * The constructor registers the record in the global list of lock statistics.
+   * @param[in] lock The address of the lock object owning this record.
+   */
+  explicit LockStatsRecord(const void* lock);
+
+  /**
+   * The destructor removes the record from the global list of lock statistics.
+   */
+  ~LockStatsRecord();
+
+  public:
+  /**
+   * @brief Records an acquisition of the lock.
+   * @param[in] startTime the timestamp taken before trying to acquire the lock.
+   * @param[in] contended true, if the lock was held by another task and the caller had to wait.
+   */
+  void OnAcquired(uint32_t startTime, bool contended);
+
+  /**
+   * @brief Records that the calling task is going to block on the lock, reports a priority inversion to the lock watchdog.
+   * The priority of the holder is taken from the last acquisition, the holder task may be deleted already.
+   * @param[in] holder The TaskHandle_t of the task holding the lock, nullptr if unknown. It is reported, but not dereferenced.
+   */
+  void OnContended(void* holder);
+
+  /**
+   * @brief Records a release of the lock, must be called before the lock is released.
+   *        Reports a hold time exceeding the budget to the lock watchdog.
+   */
+  void OnReleased();
+
+  /**
+   * @returns a copy of the recorded statistics.
+   */
+  LockStats GetStats() const;
+
+  /**
+   * @brief Resets the recorded statistics.
+   */
+  void Reset();
+
+  private:
+  template <typename RECORD, typename STATS>
+  friend class detail::StatsRegistry;
+
+  const void* const _lock;                /** The address of the lock object. */
+  std::atomic<uint32_t> _acquisitions;    /** The number of successful acquisitions. */
+  std::atomic<uint32_t> _contentions;     /** The number of contended acquisitions. */
+  std::atomic<uint64_t> _totalWaitTime;   /** The accumulated time spent waiting in contended acquisitions. */
+  std::atomic<uint32_t> _maxWaitTime;     /** The longest time spent waiting in a single acquisition. */
+  std::atomic<uint32_t> _maxHoldTime;     /** The longest time the lock was held. */
+  uint32_t _acquiredAt;                   /** The timestamp of the outermost acquisition, only accessed by the lock owner. */
+  uint32_t _depth;                        /** The recursion depth of the lock owner, only accessed by the lock owner. */
+  std::atomic<uint32_t> _holderPriority;  /** The priority of the lock owner at the outermost acquisition, read by the waiters. */
+  LockStatsRecord* _next;                 /** The next record in the global list of lock statistics. */
+};
+
+/**
+ * @brief Copies the statistics of the registered locks.
+ *        Use \a first to page through all registered locks with a small buffer.
+ * @param[out] buffer The buffer for the statistics.
+ * @param[in] count The number of entries of \a buffer.
+ * @param[in] first The index of the first registered lock to copy.
+ * @returns the number of copied entries, 0 if there are no more locks or KERNELAPI_ENABLE_LOCK_STATS is not defined.
+ */
+uint32_t GetLockStats(LockStats* buffer, uint32_t count, uint32_t first = 0);
+
+/**
+ * @brief Resets the statistics of all registered locks.
+ */
+void ResetLockStats();
+
+/**
+ * @brief Prints the statistics of all registered locks with printf as CSV lines.
+ */
+void PrintLockStats();
+
+} // namespace rtos
+
+#endif // HEADER_E60BF82E9A6D43EFB6D5D476C42C7B3C
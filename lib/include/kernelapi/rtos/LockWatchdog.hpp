@@ -0,0 +1,84 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_63E39384EDF84D4BA6CB5319E30C2B51
+#define HEADER_63E39384EDF84D4BA6CB5319E30C2B51
+
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+namespace rtos
+{
+
+/**
+ * @brief The kind of a lock watchdog event.
+ */
+enum class LockWatchdogEventType
+{
+  HoldTimeExceeded, /** A lock was held longer than the hold time budget. */
+  PriorityInversion /** A task blocked on a lock held by a task of lower priority. */
+};
+
+/**
+ * @brief An event reported by the lock watchdog.
+ */
+struct LockWatchdogEvent
+{
+  LockWatchdogEventType type;  /** The kind of the event. */
+  const void* lock;            /** The address of the lock object. */
+  TaskHandle_t holder;         /** The task holding the lock. */
+  UBaseType_t holderPriority;  /** The priority of the holder, when it acquired the lock. */
+  TaskHandle_t waiter;         /** The task blocked on the lock, nullptr for HoldTimeExceeded. */
+  UBaseType_t waiterPriority;  /** The priority of the waiter, 0 for HoldTimeExceeded. */
+  uint32_t holdTime;           /** The hold time for HoldTimeExceeded, in the time base of KERNELAPI_LOCK_STATS_TIMESTAMP(). */
+};
+
+/**
+ * @brief The callback of the lock watchdog.
+ *        HoldTimeExceeded is reported by the holder task before it releases the lock,
+ *        PriorityInversion is reported by the waiter task before it blocks on the lock.
+ * @note The callback is called in task context, it must not block and must not lock the reported lock.
+ */
+using LockWatchdogCallback = void (*)(const LockWatchdogEvent& event);
+
+/**
+ * @brief Sets the callback and the hold time budget of the lock watchdog.
+ *        The lock watchdog is a debug layer of the lock statistics, it watches every Mutex and RecursiveMutex,
+ *        thus every LockGuard using them as well.
+ * @param[in] callback The callback to be called for each event, nullptr disables the lock watchdog.
+ * @param[in] holdTimeBudget The maximum hold time in the time base of KERNELAPI_LOCK_STATS_TIMESTAMP(), 0 disables the hold time check.
+ * @note Requires KERNELAPI_ENABLE_LOCK_STATS to be defined, otherwise no events are reported.
+ * @note The holder records its priority when it acquires the lock, a waiter never dereferences the handle of the holder,
+ *       which may be deleted concurrently. Thus priority inheritance does not hide the inversion from later waiters,
+ *       but a change of the priority by the holder after it acquired the lock is not seen.
+ */
+void SetLockWatchdog(LockWatchdogCallback callback, uint32_t holdTimeBudget);
+
+namespace detail
+{
+
+/**
+ * @brief Reports HoldTimeExceeded, if \a holdTime exceeds the budget, to be called by the holder of the lock.
+ * @param[in] lock The address of the lock object.
+ * @param[in] holdTime The time the calling task held the lock.
+ * @param[in] holderPriority The priority of the calling task, recorded when it acquired the lock.
+ */
+void CheckLockHoldTime(const void* lock, uint32_t holdTime, UBaseType_t holderPriority);
+
+/**
+ * @brief Reports PriorityInversion, if \a holderPriority is lower than the priority of the calling task.
+ * @param[in] lock The address of the lock object.
+ * @param[in] holder The task holding the lock, it is reported, but not dereferenced.
+ * @param[in] holderPriority The priority of \a holder, recorded when it acquired the lock.
+ */
+void CheckLockPriorityInversion(const void* lock, TaskHandle_t holder, UBaseType_t holderPriority);
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_63E39384EDF84D4BA6CB5319E30C2B51
@@ -0,0 +1,418 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_601CA87FF8AC4FF687F85AE18F550926
+#define HEADER_601CA87FF8AC4FF687F85AE18F550926
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <freertos/FreeRTOS.h>
+
+#include <kernelapi/rtos/ByteRing.hpp>
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Span.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The MessageBuffer class passes variable length messages from a single writer to a single reader, e.g. received USB packets.
+ *        The \a N bytes of the ring are embedded in the MessageBuffer, no memory is allocated from the RTOS heap.
+ *        Each message is stored contiguously with a length header, so it can be accessed in place:
+ *        the writer fills the span returned by Reserve() and publishes it by Commit(), e.g. as DMA target,
+ *        the reader parses the span returned by Peek() and releases it by Consume().
+ *
+ * @note The semantic follows the native RTOS message buffer, see https://www.freertos.org/RTOS-message-buffer-API.html
+ *       Contrary to the native message buffer the ring is exposed for in-place access, so the MessageBuffer is implemented lock-free
+ *       on top of acquire/release atomics instead of wrapping xMessageBufferCreateStatic.
+ *       A message, which does not fit into the end of the ring, starts at the beginning of the ring and the end is skipped.
+ *
+ * @note Only one task or ISR may write and only one task or ISR may read at a time!
+ * @note A blocked task is woken up by a task notification. If configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 the last notification index is used,
+ *       otherwise index 0, do not use it for another purpose in the writer and reader tasks.
+ * @note Use the FromISR methods when called within an ISR.
+ *
+ * @tparam N The capacity in bytes including the headers, must be a power of two.
+ */
+template <size_t N>
+class MessageBuffer
+{
+  static_assert(16 <= N, "The capacity N has to be at least 16 bytes");
+
+  // Make this class non-copyable
+  public:
+  MessageBuffer(const MessageBuffer& other) = delete;
+  MessageBuffer& operator=(const MessageBuffer& other) = delete;
+
+  public:
+  MessageBuffer() :
+    _ring{},
+    _padding{0}
+  {}
+
+  public:
+  /**
+   * @returns the number of bytes the message buffer can hold including the headers.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return N;
+  }
+
+  /**
+   * @returns the maximum size of a single message, larger messages are rejected.
+   */
+  static constexpr size_t GetMaxMessageSize()
+  {
+    return (N / 2) - headerSize;
+  }
+
+  /**
+   * @brief Copies the message into the message buffer, to be called by the writer task.
+   * If there is not enough space for the message, it blocks until specified timeout has been reached.
+   * @param[in] data The message to be copied.
+   * @param[in] size The size of the message in bytes.
+   * @param[in] timeout maximum time to block until.
+   * @returns the size of the message if it was written, 0 otherwise.
+   */
+  size_t Send(const void* data, size_t size, rtos::Ticks_t timeout = 0)
+  {
+    if (!WaitForSpace(size, timeout) || !Write(data, size))
+    {
+      return 0;
+    }
+
+    Commit(size);
+    return size;
+  }
+
+  /**
+   * @brief Copies the message into the message buffer, to be called by the writer task.
+   * @param[in] data The message to be copied.
+   * @param[in] size The size of the message in bytes.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns the size of the message if it was written, 0 otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  size_t Send(const void* data, size_t size, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Send(data, size, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Copies the message into the message buffer from within an ISR.
+   * @param[in] data The message to be copied.
+   * @param[in] size The size of the message in bytes.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if sending unblocked a task of higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns the size of the message if it was written, 0 if there is not enough space.
+   */
+  size_t SendFromISR(const void* data, size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    if (!Write(data, size))
+    {
+      return 0;
+    }
+
+    CommitFromISR(size, higherPriorityTaskWoken);
+    return size;
+  }
+
+  /**
+   * @brief Copies the next message out of the message buffer, to be called by the reader task.
+   * If the message buffer is empty, it blocks until specified timeout has been reached.
+   * @param[out] buffer The buffer for the message.
+   * @param[in] size The number of bytes the buffer can hold.
+   * @param[in] timeout maximum time to block until.
+   * @returns the size of the message, 0 if there is no message or the message does not fit into the buffer.
+   *          A message, which does not fit into the buffer, is not removed, check GetNextLength().
+   */
+  size_t Receive(void* buffer, size_t size, rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    _ring.WaitForBytes(1, timeout);
+    const size_t read = Read(buffer, size);
+    if (0 != read)
+    {
+      Consume();
+    }
+
+    return read;
+  }
+
+  /**
+   * @brief Copies the next message out of the message buffer, to be called by the reader task.
+   * @param[out] buffer The buffer for the message.
+   * @param[in] size The number of bytes the buffer can hold.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns the size of the message, 0 if there is no message or the message does not fit into the buffer.
+   */
+  template <typename REP, typename PERIOD>
+  size_t Receive(void* buffer, size_t size, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Receive(buffer, size, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Copies the next message out of the message buffer from within an ISR.
+   * @param[out] buffer The buffer for the message.
+   * @param[in] size The number of bytes the buffer can hold.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   * @returns the size of the message, 0 if there is no message or the message does not fit into the buffer.
+   */
+  size_t ReceiveFromISR(void* buffer, size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    const size_t read = Read(buffer, size);
+    if (0 != read)
+    {
+      ConsumeFromISR(higherPriorityTaskWoken);
+    }
+
+    return read;
+  }
+
+  /**
+   * @brief Reserves a contiguous message of \a size bytes for in-place writing, to be called by the writer.
+   * @param[in] size The maximum size of the message, at most GetMaxMessageSize().
+   * @returns the span of the reserved message, it is empty if there is not enough space.
+   */
+  Span<uint8_t> Reserve(size_t size)
+  {
+    if ((0 == size) || (GetMaxMessageSize() < size))
+    {
+      return Span<uint8_t>{};
+    }
+
+    const size_t head = _ring.GetHead();
+    const size_t padding = GetPadding(head, size);
+    if (_ring.GetSpacesAvailable() < (padding + headerSize + Align(size)))
+    {
+      return Span<uint8_t>{};
+    }
+
+    if (0 != padding)
+    {
+      StoreHeader(head, paddingMarker);
+    }
+
+    _padding = padding;
+    return Span<uint8_t>{_ring.At(head + padding + headerSize), size};
+  }
+
+  /**
+   * @brief Publishes the last reservation as a message of \a size bytes to the reader.
+   * @param[in] size The size of the message, at least 1 and at most the size of the reserved span.
+   */
+  void Commit(size_t size)
+  {
+    assert((0 < size) && "Empty messages are not supported");
+    StoreHeader(_ring.GetHead() + _padding, static_cast<uint32_t>(size));
+    _ring.Commit(_padding + headerSize + Align(size));
+  }
+
+  /**
+   * @brief Publishes the last reservation as a message of \a size bytes to the reader from within an ISR.
+   * @param[in] size The size of the message, at least 1 and at most the size of the reserved span.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   */
+  void CommitFromISR(size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    assert((0 < size) && "Empty messages are not supported");
+    StoreHeader(_ring.GetHead() + _padding, static_cast<uint32_t>(size));
+
+    BaseType_t woken {pdFALSE};
+    _ring.CommitFromISR(_padding + headerSize + Align(size), &woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  }
+
+  /**
+   * @brief Waits until a message of \a size bytes fits into the message buffer, to be called by the writer task.
+   * @param[in] size The size of the message, at most GetMaxMessageSize().
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the message fits, false if the timeout has been reached.
+   */
+  bool WaitForSpace(size_t size, rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    if ((0 == size) || (GetMaxMessageSize() < size))
+    {
+      return false;
+    }
+
+    const size_t head = _ring.GetHead();
+    return _ring.WaitForSpaces(GetPadding(head, size) + headerSize + Align(size), timeout);
+  }
+
+  /**
+   * @brief Returns the next message for in-place reading, to be called by the reader.
+   * @returns the span of the next message, it is empty if the message buffer is empty.
+   */
+  Span<const uint8_t> Peek()
+  {
+    if (0 == _ring.GetBytesAvailable())
+    {
+      return Span<const uint8_t>{};
+    }
+
+    const size_t start = GetMessageStart();
+    return Span<const uint8_t>{_ring.At(start + headerSize), LoadHeader(start)};
+  }
+
+  /**
+   * @brief Removes the next message from the message buffer, so its bytes can be written again.
+   */
+  void Consume()
+  {
+    if (0 != _ring.GetBytesAvailable())
+    {
+      _ring.Consume(GetMessageEnd() - _ring.GetTail());
+    }
+  }
+
+  /**
+   * @brief Removes the next message from the message buffer from within an ISR.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   */
+  void ConsumeFromISR(BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    if (0 != _ring.GetBytesAvailable())
+    {
+      BaseType_t woken {pdFALSE};
+      _ring.ConsumeFromISR(GetMessageEnd() - _ring.GetTail(), &woken);
+      detail::YieldFromISR(woken, higherPriorityTaskWoken);
+    }
+  }
+
+  /**
+   * @brief Waits until a message is available, to be called by the reader task.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if a message is available, false if the timeout has been reached.
+   */
+  bool WaitForData(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    return _ring.WaitForBytes(1, timeout);
+  }
+
+  /**
+   * @brief Waits until a message is available, to be called by the reader task.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if a message is available, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool WaitForData(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return WaitForData(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @returns the size of the next message, 0 if the message buffer is empty.
+   */
+  size_t GetNextLength()
+  {
+    return Peek().GetSize();
+  }
+
+  /**
+   * @returns the number of free bytes including the space for headers.
+   */
+  size_t GetSpacesAvailable() const
+  {
+    return _ring.GetSpacesAvailable();
+  }
+
+  /**
+   * @returns true if the message buffer does not contain any message.
+   */
+  bool IsEmpty() const
+  {
+    return (0 == _ring.GetBytesAvailable());
+  }
+
+  /**
+   * @brief Removes all messages from the message buffer.
+   * @note Must not be called while a writer or reader accesses the message buffer.
+   */
+  void Reset()
+  {
+    _ring.Reset();
+  }
+
+  private:
+  static constexpr size_t headerSize {sizeof(uint32_t)};
+  static constexpr uint32_t paddingMarker {UINT32_MAX};
+
+  // Messages are word aligned, so a header never wraps around the end of the ring.
+  static constexpr size_t Align(size_t size)
+  {
+    return (size + headerSize - 1) & ~(headerSize - 1);
+  }
+
+  // Returns the number of bytes skipped at the end of the ring, if the message does not fit contiguously at \a head.
+  static constexpr size_t GetPadding(size_t head, size_t size)
+  {
+    const size_t contiguous = detail::ByteRing<N>::GetContiguous(head);
+    return (contiguous < (headerSize + Align(size))) ? contiguous : 0;
+  }
+
+  bool Write(const void* data, size_t size)
+  {
+    const Span<uint8_t> span = Reserve(size);
+    if (span.IsEmpty())
+    {
+      return false;
+    }
+
+    std::memcpy(span.GetData(), data, size);
+    return true;
+  }
+
+  size_t Read(void* buffer, size_t size)
+  {
+    const Span<const uint8_t> span = Peek();
+    if (size < span.GetSize())
+    {
+      return 0;
+    }
+
+    std::memcpy(buffer, span.GetData(), span.GetSize());
+    return span.GetSize();
+  }
+
+  // Returns the index of the header of the next message, skipping the padding at the end of the ring.
+  size_t GetMessageStart()
+  {
+    const size_t tail = _ring.GetTail();
+    return (paddingMarker == LoadHeader(tail)) ? (tail + detail::ByteRing<N>::GetContiguous(tail)) : tail;
+  }
+
+  // Returns the index behind the next message.
+  size_t GetMessageEnd()
+  {
+    const size_t start = GetMessageStart();
+    return start + headerSize + Align(LoadHeader(start));
+  }
+
+  uint32_t LoadHeader(size_t index)
+  {
+    uint32_t header {0};
+    std::memcpy(&header, _ring.At(index), headerSize);
+    return header;
+  }
+
+  void StoreHeader(size_t index, uint32_t header)
+  {
+    std::memcpy(_ring.At(index), &header, headerSize);
+  }
+
+  private:
+  detail::ByteRing<N> _ring; /** The messages with their headers. */
+  size_t _padding;           /** The padding of the last reservation, only accessed by the writer. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_601CA87FF8AC4FF687F85AE18F550926
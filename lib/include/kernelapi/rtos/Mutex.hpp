@@ -6,11 +6,20 @@
 #ifndef HEADER_CE2B7FA614264CF0B6C4409A6D665B52
 #define HEADER_CE2B7FA614264CF0B6C4409A6D665B52
 
+#include <atomic>
+#include <cstdint>
+
+#include <kernelapi/rtos/LazyCreate.hpp>
+#include <kernelapi/rtos/LockStats.hpp>
 #include <kernelapi/rtos/Ticks.hpp>
 
 namespace rtos
 {
 
+// The layout depends on KERNELAPI_ENABLE_LOCK_STATS, see LockStats.hpp.
+inline namespace KERNELAPI_LOCK_STATS_ABI
+{
+
 /**
  * @brief The Mutex class is a synchronization primitive that can be used to protect shared data from being simultaneously accessed by multiple tasks.
  *        The Mutex includes a priority inheritance mechanism for eliminating unbounded priority inversion.
@@ -42,6 +51,26 @@ class Mutex
    */
   Mutex();
 
+  /**
+   * Creates the native RTOS mutex in adaptive mode.
+   * In adaptive mode TryLockFor() and Lock() spin on TryLock() for at most \a maxSpinCount iterations, before blocking on the native mutex.
+   * Choose a small count: The spin does not check if the task holding the mutex is running on another core.
+   * This avoids two context switches when the holder releases the mutex within a few microseconds.
+   * The spin phase is part of the timeout of TryLockFor(), the remaining time is spent blocking.
+   * @param[in] maxSpinCount maximum number of spin iterations, 0 disables the adaptive mode.
+   * @note Call IsValid() to verify if the mutex was created successfully.
+   */
+  explicit Mutex(uint32_t maxSpinCount);
+
+  /**
+   * Defers creating the native RTOS mutex until the first call of Lock(), TryLock() or TryLockFor().
+   * Concurrent first calls are resolved atomically, exactly one native mutex is kept.
+   * @param[in] maxSpinCount maximum number of spin iterations of the adaptive mode, 0 disables the adaptive mode.
+   * @note Use IsCreated() to check whether the native mutex has been created already.
+   *       If the creation fails, it is not retried: IsValid() returns false, TryLock() fails and Lock() asserts.
+   */
+  explicit Mutex(LazyCreate, uint32_t maxSpinCount = 0);
+
   /**
    * @brief Take and destroy the mutex handle.
    */
@@ -49,10 +78,27 @@ class Mutex
 
   public:
   /**
-   * @returns true if the mutex was created successfully, false otherwise.
+   * @returns true if the mutex was created successfully or if its creation is deferred to the first use (LazyCreate), false otherwise.
+   *          false as well, once the deferred creation has failed.
    */
   bool IsValid() const;
 
+  /**
+   * @returns true if the native mutex has been created, false if its creation is still deferred or has failed.
+   */
+  bool IsCreated() const;
+
+  /**
+   * @brief Sets the maximum number of spin iterations of the adaptive mode.
+   * @param[in] maxSpinCount maximum number of spin iterations, 0 disables the adaptive mode.
+   */
+  void SetMaxSpinCount(uint32_t maxSpinCount);
+
+  /**
+   * @returns the maximum number of spin iterations of the adaptive mode, 0 if the adaptive mode is disabled.
+   */
+  uint32_t GetMaxSpinCount() const;
+
   /**
    * @brief Locks the mutex.
    * Blocks until mutex is available.
@@ -74,6 +120,18 @@ class Mutex
    */
   bool TryLockFor(rtos::Ticks_t timeout);
 
+  /**
+   * @brief Tries to lock the mutex.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
   /**
    * @brief Unlocks the mutex.
    */
@@ -86,9 +144,37 @@ class Mutex
 
   private:
   using NativeHdl = void*;
-  NativeHdl _handle; /** The native mutex handle managed by an instance of this class. */
+
+  /**
+   * @returns the native mutex handle, creates the native mutex if its creation was deferred.
+   */
+  NativeHdl GetHandle();
+
+  /**
+   * @brief Takes the native mutex.
+   * @param[in] timeout maximum time to block until.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  bool Take(rtos::Ticks_t timeout);
+
+  /**
+   * @brief Spins on TryLock() for at most \a _maxSpinCount iterations.
+   * @returns true if it owns the lock, false if the spin iterations are exhausted or the calling task is the holder.
+   */
+  bool TrySpinLock();
+
+  private:
+  std::atomic<NativeHdl> _handle; /** The native mutex handle managed by an instance of this class. */
+  bool _lazy; /** True if the native mutex is created on first use. */
+  std::atomic<bool> _createFailed; /** True if the deferred creation of the native mutex has failed. */
+  uint32_t _maxSpinCount; /** The maximum number of spin iterations in adaptive mode, 0 if disabled. */
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  rtos::LockStatsRecord _lockStats; /** The contention statistics of this mutex. */
+#endif
 };
 
+} // namespace KERNELAPI_LOCK_STATS_ABI
+
 } // namespace rtos
 
 #endif // HEADER_CE2B7FA614264CF0B6C4409A6D665B52
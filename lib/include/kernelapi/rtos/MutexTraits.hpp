@@ -0,0 +1,72 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_CCADA3020B734D74B264D5F3B0BD3BFB
+#define HEADER_CCADA3020B734D74B264D5F3B0BD3BFB
+
+#include <type_traits>
+#include <utility>
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The mutex requirements of the library, checked at compile time by the lock guards.
+ *
+ *        BasicLockable: void Lock() and void Unlock(), e.g. used by ScopedLock<MUTEX>.
+ *        Lockable:      BasicLockable and bool TryLock(), e.g. used by LockGuard, UniqueLock and SpinLock.
+ *        TimedLockable: Lockable and bool TryLockFor(rtos::Ticks_t), e.g. Mutex, RecursiveMutex and NullMutex.
+ *        SharedLockable: void LockShared(), bool TryLockShared(), bool TryLockSharedFor(rtos::Ticks_t) and void UnlockShared(),
+ *                        e.g. SharedMutex, used by SharedLockGuard.
+ *
+ * @note Any type fulfilling the requirements can be used as lock policy, e.g. select NullMutex for single-task builds.
+ */
+template <typename MUTEX, typename = void>
+struct IsBasicLockable : std::false_type {};
+
+template <typename MUTEX>
+struct IsBasicLockable<MUTEX, std::void_t<decltype(std::declval<MUTEX&>().Lock()),
+                                          decltype(std::declval<MUTEX&>().Unlock())>> : std::true_type {};
+
+template <typename MUTEX, typename = void>
+struct IsLockable : std::false_type {};
+
+template <typename MUTEX>
+struct IsLockable<MUTEX, std::enable_if_t<IsBasicLockable<MUTEX>::value &&
+                                          std::is_convertible_v<decltype(std::declval<MUTEX&>().TryLock()), bool>>> : std::true_type {};
+
+template <typename MUTEX, typename = void>
+struct IsTimedLockable : std::false_type {};
+
+template <typename MUTEX>
+struct IsTimedLockable<MUTEX, std::enable_if_t<IsLockable<MUTEX>::value &&
+                                               std::is_convertible_v<decltype(std::declval<MUTEX&>().TryLockFor(std::declval<rtos::Ticks_t>())), bool>>> : std::true_type {};
+
+template <typename MUTEX, typename = void>
+struct IsSharedLockable : std::false_type {};
+
+template <typename MUTEX>
+struct IsSharedLockable<MUTEX, std::enable_if_t<std::is_convertible_v<decltype(std::declval<MUTEX&>().TryLockShared()), bool> &&
+                                                std::is_convertible_v<decltype(std::declval<MUTEX&>().TryLockSharedFor(std::declval<rtos::Ticks_t>())), bool>,
+                                                std::void_t<decltype(std::declval<MUTEX&>().LockShared()),
+                                                            decltype(std::declval<MUTEX&>().UnlockShared())>>> : std::true_type {};
+
+template <typename MUTEX>
+constexpr bool isBasicLockable = IsBasicLockable<MUTEX>::value;
+
+template <typename MUTEX>
+constexpr bool isLockable = IsLockable<MUTEX>::value;
+
+template <typename MUTEX>
+constexpr bool isTimedLockable = IsTimedLockable<MUTEX>::value;
+
+template <typename MUTEX>
+constexpr bool isSharedLockable = IsSharedLockable<MUTEX>::value;
+
+} // namespace rtos
+
+#endif // HEADER_CCADA3020B734D74B264D5F3B0BD3BFB
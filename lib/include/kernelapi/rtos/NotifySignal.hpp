@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_CF6865C13DF14482B0F469249D403E84
+#define HEADER_CF6865C13DF14482B0F469249D403E84
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/TaskSemaphore.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The NotifySignal class is a lightweight binary event, e.g. to hand over from an ISR to a task.
+ *        Signalling it several times before the owner task waits results in a single wakeup.
+ *        Like the TaskSemaphore, it is built on the direct to task notification of the owner task.
+ *
+ * @note The NotifySignal uses the task notification (index 0) of the owner task, do not use it for another purpose.
+ *
+ * @note Only the owner task may call Wait()! Use SignalFromISR() within an ISR.
+ */
+class NotifySignal : private TaskSemaphore
+{
+  public:
+  using TaskSemaphore::TaskSemaphore;
+  using TaskSemaphore::SetOwner;
+  using TaskSemaphore::GetOwner;
+
+  /**
+   * @brief Sets the signal and unblocks the owner task if it is waiting.
+   */
+  void Signal()
+  {
+    Give();
+  }
+
+  /**
+   * @brief Sets the signal from within an ISR.
+   * @param[out] higherPriorityTaskWoken See TaskSemaphore::GiveFromISR().
+   */
+  void SignalFromISR(BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    GiveFromISR(higherPriorityTaskWoken);
+  }
+
+  /**
+   * @brief Waits for the signal and clears it.
+   * If the signal is not set, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the signal was set, false if the timeout has been reached.
+   */
+  bool Wait(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    return (0 != TakeAll(timeout));
+  }
+
+  /**
+   * @brief Waits for the signal and clears it.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the signal was set, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool Wait(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Wait(rtos::ToTicks(timeout));
+  }
+};
+
+} // namespace rtos
+
+#endif // HEADER_CF6865C13DF14482B0F469249D403E84
@@ -0,0 +1,98 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A870438C624441F08DE5486416C4B8A9
+#define HEADER_A870438C624441F08DE5486416C4B8A9
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The NullMutex class fulfills the mutex requirements, but does not lock anything.
+ *        All methods are empty and compile to nothing, so selecting NullMutex as lock policy removes the locking overhead entirely,
+ *        e.g. LockGuard<NullMutex> for a component which is only used by a single task.
+ *        The NullMutex supports the exclusive and the shared mode, see MutexTraits.hpp.
+ *
+ * @note Only use the NullMutex, when the protected data is never accessed by more than one task or ISR!
+ */
+class NullMutex final
+{
+  // Make this class non-copyable
+  public:
+  NullMutex(const NullMutex& other) = delete;
+  NullMutex& operator=(const NullMutex& other) = delete;
+
+  public:
+  constexpr NullMutex() = default;
+
+  public:
+  /**
+   * @returns always true.
+   */
+  constexpr bool IsValid() const { return true; }
+
+  /**
+   * @brief Does nothing.
+   */
+  constexpr void Lock() {}
+
+  /**
+   * @returns always true.
+   */
+  constexpr bool TryLock() { return true; }
+
+  /**
+   * @returns always true.
+   */
+  constexpr bool TryLockFor(rtos::Ticks_t) { return true; }
+
+  /**
+   * @returns always true.
+   */
+  template <typename REP, typename PERIOD>
+  constexpr bool TryLockFor(const std::chrono::duration<REP, PERIOD>&) { return true; }
+
+  /**
+   * @brief Does nothing.
+   */
+  constexpr void Unlock() {}
+
+  /**
+   * @returns always false.
+   */
+  constexpr bool IsLocked() { return false; }
+
+  /**
+   * @brief Does nothing.
+   */
+  constexpr void LockShared() {}
+
+  /**
+   * @returns always true.
+   */
+  constexpr bool TryLockShared() { return true; }
+
+  /**
+   * @returns always true.
+   */
+  constexpr bool TryLockSharedFor(rtos::Ticks_t) { return true; }
+
+  /**
+   * @returns always true.
+   */
+  template <typename REP, typename PERIOD>
+  constexpr bool TryLockSharedFor(const std::chrono::duration<REP, PERIOD>&) { return true; }
+
+  /**
+   * @brief Does nothing.
+   */
+  constexpr void UnlockShared() {}
+};
+
+} // namespace rtos
+
+#endif // HEADER_A870438C624441F08DE5486416C4B8A9
@@ -0,0 +1,140 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_616AAC57145C4F2C9A7FB06E8773EB5D
+#define HEADER_616AAC57145C4F2C9A7FB06E8773EB5D
+
+namespace rtos
+{
+
+/**
+ * @brief The class PoolPtr owns an object allocated from a memory pool, e.g. from a BlockPool, and returns it to the pool when it
+ *        goes out of scope. The PoolPtr is movable, so the ownership can be passed on, e.g. through a PointerQueue after Release().
+ *        The PoolPtr class is non-copyable.
+ * @note The PoolPtr was inspired by the C++11 implementation of unique_ptr.
+ */
+template <typename T>
+class PoolPtr
+{
+  // Make this class non-copyable
+  public:
+  PoolPtr(const PoolPtr& other) = delete;
+  PoolPtr& operator=(const PoolPtr& other) = delete;
+
+  public:
+  /**
+   * @brief Returns an object to its pool.
+   */
+  using Deleter = void (*)(void* pool, T* object);
+
+  /**
+   * Creates an empty PoolPtr.
+   */
+  PoolPtr() noexcept :
+    _object(nullptr), _pool(nullptr), _deleter(nullptr)
+  {}
+
+  /**
+   * Takes the ownership of \a object.
+   * @param[in] object The object allocated from \a pool, may be nullptr.
+   * @param[in] pool The pool of the object.
+   * @param[in] deleter Returns the object to the pool.
+   */
+  PoolPtr(T* object, void* pool, Deleter deleter) noexcept :
+    _object(object), _pool(pool), _deleter(deleter)
+  {}
+
+  /**
+   * Takes over the object of \a other.
+   */
+  PoolPtr(PoolPtr&& other) noexcept :
+    _object(other._object), _pool(other._pool), _deleter(other._deleter)
+  {
+    other._object = nullptr;
+  }
+
+  /**
+   * Returns the owned object to its pool and takes over the object of \a other.
+   */
+  PoolPtr& operator=(PoolPtr&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Reset();
+      _object = other._object;
+      _pool = other._pool;
+      _deleter = other._deleter;
+      other._object = nullptr;
+    }
+
+    return *this;
+  }
+
+  /**
+   * Returns the owned object to its pool.
+   */
+  ~PoolPtr()
+  {
+    Reset();
+  }
+
+  /**
+   * @brief Returns the owned object to its pool.
+   */
+  void Reset() noexcept
+  {
+    if (nullptr != _object)
+    {
+      _deleter(_pool, _object);
+      _object = nullptr;
+    }
+  }
+
+  /**
+   * @brief Gives up the ownership without returning the object to its pool.
+   * @returns the object, the caller is responsible to return it to its pool.
+   */
+  T* Release() noexcept
+  {
+    T* const object = _object;
+    _object = nullptr;
+    return object;
+  }
+
+  /**
+   * @returns the owned object, nullptr if empty.
+   */
+  T* Get() const noexcept
+  {
+    return _object;
+  }
+
+  T* operator->() const noexcept
+  {
+    return _object;
+  }
+
+  T& operator*() const noexcept
+  {
+    return *_object;
+  }
+
+  /**
+   * @returns true if an object is owned.
+   */
+  explicit operator bool() const noexcept
+  {
+    return (nullptr != _object);
+  }
+
+  private:
+  T* _object;        /** The owned object. */
+  void* _pool;       /** The pool of the owned object. */
+  Deleter _deleter;  /** Returns the object to the pool. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_616AAC57145C4F2C9A7FB06E8773EB5D
@@ -0,0 +1,131 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A312B33D1E094D4FB2371AFC7E6911D1
+#define HEADER_A312B33D1E094D4FB2371AFC7E6911D1
+
+#include <atomic>
+#include <cstdint>
+
+// KERNELAPI_ENABLE_POOL_STATS changes the layout of the pools, which embed a PoolStatsRecord, so it is an ABI-affecting option:
+// Define it for all code sharing a pool, or for none. The pools are declared within an inline namespace named after it,
+// thus code sharing a pool with a different setting fails to link, instead of silently violating the one definition rule.
+#if defined(KERNELAPI_ENABLE_POOL_STATS)
+  #define KERNELAPI_POOL_STATS_ABI pool_stats
+#else
+  #define KERNELAPI_POOL_STATS_ABI no_pool_stats
+#endif
+
+namespace rtos
+{
+
+namespace detail
+{
+template <typename RECORD, typename STATS>
+class StatsRegistry;
+} // namespace detail
+
+/**
+ * @brief The statistics of a single memory pool.
+ */
+struct PoolStats
+{
+  const void* pool;      /** The address of the pool object. */
+  uint32_t capacity;     /** The number of blocks of the pool. */
+  uint32_t allocations;  /** The number of successful allocations. */
+  uint32_t exhaustions;  /** The number of allocations, which failed because the pool was exhausted. */
+  uint32_t inUse;        /** The number of currently allocated blocks. */
+  uint32_t maxInUse;     /** The maximum number of allocated blocks at the same time. */
+};
+
+/**
+ * @brief The PoolStatsRecord class records the statistics of a single memory pool and registers them in the global list of pool statistics.
+ *        A pool embeds a PoolStatsRecord only when KERNELAPI_ENABLE_POOL_STATS is defined, otherwise the instrumentation
+ *        has no cost at all. The macro changes the layout of the pools, see KERNELAPI_POOL_STATS_ABI.
+ *
+ * @note The counters are atomic, the methods can be called from any task or ISR.
+ */
+class PoolStatsRecord
+{
+  // Make this class non-copyable
+  public:
+  PoolStatsRecord(const PoolStatsRecord& other) = delete;
+  PoolStatsRecord& operator=(const PoolStatsRecord& other) = delete;
+
+  public:
+  /**
+   * The constructor registers the record in the global list of pool statistics.
+   * @param[in] pool The address of the pool object owning this record.
+   * @param[in] capacity The number of blocks of the pool.
+   */
+  PoolStatsRecord(const void* pool, uint32_t capacity);
+
+  /**
+   * The destructor removes the record from the global list of pool statistics.
+   */
+  ~PoolStatsRecord();
+
+  public:
+  /**
+   * @brief Records a successful allocation.
+   */
+  void OnAllocated();
+
+  /**
+   * @brief Records an allocation, which failed because the pool was exhausted.
+   */
+  void OnExhausted();
+
+  /**
+   * @brief Records the release of a block.
+   */
+  void OnFreed();
+
+  /**
+   * @returns a copy of the recorded statistics.
+   */
+  PoolStats GetStats() const;
+
+  /**
+   * @brief Resets the recorded statistics, except the number of allocated blocks.
+   */
+  void Reset();
+
+  private:
+  template <typename RECORD, typename STATS>
+  friend class detail::StatsRegistry;
+
+  const void* const _pool;             /** The address of the pool object. */
+  const uint32_t _capacity;            /** The number of blocks of the pool. */
+  std::atomic<uint32_t> _allocations;  /** The number of successful allocations. */
+  std::atomic<uint32_t> _exhaustions;  /** The number of failed allocations. */
+  std::atomic<uint32_t> _inUse;        /** The number of currently allocated blocks. */
+  std::atomic<uint32_t> _maxInUse;     /** The maximum number of allocated blocks. */
+  PoolStatsRecord* _next;              /** The next record in the global list of pool statistics. */
+};
+
+/**
+ * @brief Copies the statistics of the registered pools.
+ *        Use \a first to page through all registered pools with a small buffer.
+ * @param[out] buffer The buffer for the statistics.
+ * @param[in] count The number of entries of \a buffer.
+ * @param[in] first The index of the first registered pool to copy.
+ * @returns the number of copied entries, 0 if there are no more pools or KERNELAPI_ENABLE_POOL_STATS is not defined.
+ */
+uint32_t GetPoolStats(PoolStats* buffer, uint32_t count, uint32_t first = 0);
+
+/**
+ * @brief Resets the statistics of all registered pools.
+ */
+void ResetPoolStats();
+
+/**
+ * @brief Prints the statistics of all registered pools with printf as CSV lines.
+ */
+void PrintPoolStats();
+
+} // namespace rtos
+
+#endif // HEADER_A312B33D1E094D4FB2371AFC7E6911D1
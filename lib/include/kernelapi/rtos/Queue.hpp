@@ -0,0 +1,289 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_787B606F27ED46A982ACB1DD2683276A
+#define HEADER_787B606F27ED46A982ACB1DD2683276A
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The Queue class is a typed FIFO for passing items of type T between tasks and ISRs.
+ *        The queue storage for \a N items and the native queue object are embedded in the Queue, no memory is allocated from the RTOS heap.
+ *        Items are copied into and out of the queue by the kernel, thus T has to be trivially copyable.
+ *        To pass large payloads, use a PointerQueue so only a pointer is copied through the kernel.
+ *
+ * @note The Queue class is a wrapper class for the native RTOS queue implementation.
+ *       See https://www.freertos.org/xQueueCreateStatic.html for details.
+ *       Requires configSUPPORT_STATIC_ALLOCATION to be enabled in the RTOS configuration.
+ *
+ * @note Like Mutex::TryLockFor(), the blocking methods take an explicit timeout: 0 does not block, GetMaxDelay() waits forever.
+ * @note Use the FromISR methods when called within an ISR.
+ */
+template <typename T, size_t N>
+class Queue
+{
+  static_assert(std::is_trivially_copyable_v<T>, "The items are copied by the kernel, T has to be trivially copyable");
+  static_assert(0 < N, "The queue needs at least one item");
+
+  // Make this class non-copyable
+  public:
+  Queue(const Queue& other) = delete;
+  Queue& operator=(const Queue& other) = delete;
+
+  public:
+  /**
+   * The default constructor.
+   * Creates the native RTOS queue within the embedded storage and stores the handle to it.
+   */
+  Queue() :
+    _storage{},
+    _queue{},
+    _handle{nullptr}
+  {
+    _handle = xQueueCreateStatic(N, sizeof(T), _storage, &_queue);
+    assert(_handle && "Failed to create the queue");
+  }
+
+  /**
+   * @brief Destroy the queue handle.
+   */
+  ~Queue()
+  {
+    vQueueDelete(_handle);
+  }
+
+  public:
+  /**
+   * @returns true if the queue was created successfully, false otherwise.
+   */
+  bool IsValid() const
+  {
+    return (nullptr != _handle);
+  }
+
+  /**
+   * @returns the number of items the queue can hold.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return N;
+  }
+
+  /**
+   * @brief Copies the item to the back of the queue.
+   * If the queue is full, it blocks until specified timeout has been reached.
+   * @param[in] item The item to be copied into the queue.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the item was sent, false if the queue was full.
+   */
+  bool Send(const T& item, rtos::Ticks_t timeout)
+  {
+    return (pdTRUE == xQueueSend(_handle, &item, timeout));
+  }
+
+  /**
+   * @brief Copies the item to the back of the queue.
+   * If the queue is full, it blocks until specified timeout has been reached.
+   * @param[in] item The item to be copied into the queue.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the item was sent, false if the queue was full.
+   */
+  template <typename REP, typename PERIOD>
+  bool Send(const T& item, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Send(item, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Copies the item to the front of the queue.
+   * If the queue is full, it blocks until specified timeout has been reached.
+   * @param[in] item The item to be copied into the queue.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the item was sent, false if the queue was full.
+   */
+  bool SendToFront(const T& item, rtos::Ticks_t timeout)
+  {
+    return (pdTRUE == xQueueSendToFront(_handle, &item, timeout));
+  }
+
+  /**
+   * @brief Copies the item to the front of the queue.
+   * If the queue is full, it blocks until specified timeout has been reached.
+   * @param[in] item The item to be copied into the queue.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the item was sent, false if the queue was full.
+   */
+  template <typename REP, typename PERIOD>
+  bool SendToFront(const T& item, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return SendToFront(item, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Overwrites the item of a single item queue, e.g. to publish the latest value.
+   * @param[in] item The item to be copied into the queue.
+   */
+  void Overwrite(const T& item)
+  {
+    static_assert(1 == N, "Overwrite is only supported by single item queues");
+    [[maybe_unused]] const BaseType_t ret = xQueueOverwrite(_handle, &item);
+  }
+
+  /**
+   * @brief Copies the item to the back of the queue from within an ISR.
+   * @param[in] item The item to be copied into the queue.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if sending unblocked a task of higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns true if the item was sent, false if the queue was full.
+   */
+  bool SendFromISR(const T& item, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    BaseType_t woken {pdFALSE};
+    const BaseType_t ret = xQueueSendFromISR(_handle, &item, &woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+    return (pdTRUE == ret);
+  }
+
+  /**
+   * @brief Overwrites the item of a single item queue from within an ISR.
+   * @param[in] item The item to be copied into the queue.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   */
+  void OverwriteFromISR(const T& item, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    static_assert(1 == N, "Overwrite is only supported by single item queues");
+    BaseType_t woken {pdFALSE};
+    [[maybe_unused]] const BaseType_t ret = xQueueOverwriteFromISR(_handle, &item, &woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  }
+
+  /**
+   * @brief Receives the item from the front of the queue and removes it from the queue.
+   * If the queue is empty, it blocks until specified timeout has been reached.
+   * @param[out] item The received item.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if an item was received, false if the queue was empty.
+   */
+  bool Receive(T& item, rtos::Ticks_t timeout)
+  {
+    return (pdTRUE == xQueueReceive(_handle, &item, timeout));
+  }
+
+  /**
+   * @brief Receives the item from the front of the queue and removes it from the queue.
+   * If the queue is empty, it blocks until specified timeout has been reached.
+   * @param[out] item The received item.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if an item was received, false if the queue was empty.
+   */
+  template <typename REP, typename PERIOD>
+  bool Receive(T& item, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Receive(item, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Receives the item from the front of the queue without removing it from the queue.
+   * If the queue is empty, it blocks until specified timeout has been reached.
+   * @param[out] item The received item.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if an item was received, false if the queue was empty.
+   */
+  bool Peek(T& item, rtos::Ticks_t timeout)
+  {
+    return (pdTRUE == xQueuePeek(_handle, &item, timeout));
+  }
+
+  /**
+   * @brief Receives the item from the front of the queue and removes it from the queue within an ISR.
+   * @param[out] item The received item.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   * @returns true if an item was received, false if the queue was empty.
+   */
+  bool ReceiveFromISR(T& item, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    BaseType_t woken {pdFALSE};
+    const BaseType_t ret = xQueueReceiveFromISR(_handle, &item, &woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+    return (pdTRUE == ret);
+  }
+
+  /**
+   * @returns the number of items in the queue.
+   */
+  size_t GetCount() const
+  {
+    return uxQueueMessagesWaiting(_handle);
+  }
+
+  /**
+   * @returns the number of items in the queue, to be called within an ISR.
+   */
+  size_t GetCountFromISR() const
+  {
+    return uxQueueMessagesWaitingFromISR(_handle);
+  }
+
+  /**
+   * @returns the number of free items in the queue.
+   */
+  size_t GetSpaces() const
+  {
+    return uxQueueSpacesAvailable(_handle);
+  }
+
+  /**
+   * @returns true if the queue does not contain any item.
+   */
+  bool IsEmpty() const
+  {
+    return (0 == GetCount());
+  }
+
+  /**
+   * @returns true if the queue can not take any further item.
+   */
+  bool IsFull() const
+  {
+    return (0 == GetSpaces());
+  }
+
+  /**
+   * @brief Removes all items from the queue.
+   */
+  void Reset()
+  {
+    [[maybe_unused]] const BaseType_t ret = xQueueReset(_handle);
+  }
+
+  private:
+  alignas(T) uint8_t _storage[N * sizeof(T)]; /** The memory of the queued items. */
+  StaticQueue_t _queue;                       /** The memory of the native queue. */
+  QueueHandle_t _handle;                      /** The native queue handle managed by an instance of this class. */
+};
+
+/**
+ * @brief The PointerQueue passes large payloads of type T by pointer, so only the pointer is copied through the kernel.
+ *        The ownership of the payload is passed with the pointer: the sender must not access the payload after sending it,
+ *        and the payload must stay valid until the receiver is done with it, e.g. by allocating it from a memory pool.
+ */
+template <typename T, size_t N>
+using PointerQueue = Queue<T*, N>;
+
+} // namespace rtos
+
+#endif // HEADER_787B606F27ED46A982ACB1DD2683276A
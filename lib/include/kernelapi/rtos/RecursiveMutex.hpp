@@ -6,11 +6,20 @@
 #ifndef HEADER_C0465C280F6C424C96B2A59E5D2195B9			   
 #define HEADER_C0465C280F6C424C96B2A59E5D2195B9
 
+#include <atomic>
+#include <cstdint>
+
+#include <kernelapi/rtos/LazyCreate.hpp>
+#include <kernelapi/rtos/LockStats.hpp>
 #include <kernelapi/rtos/Ticks.hpp>
 
 namespace rtos
 {
 
+// The layout depends on KERNELAPI_ENABLE_LOCK_STATS, see LockStats.hpp.
+inline namespace KERNELAPI_LOCK_STATS_ABI
+{
+
 /**
  * @brief The RecursiveMutex class is a synchronization primitive that can be used to protect shared data from being simultaneously accessed by multiple tasks.
  *        The RecursiveMutex includes a priority inheritance mechanism for eliminating unbounded priority inversion.
@@ -30,6 +39,16 @@ class RecursiveMutex
   RecursiveMutex(const RecursiveMutex& other) = delete;
   RecursiveMutex& operator=(const RecursiveMutex& other) = delete;
 
+  public:
+  /**
+   * @brief The way the recursion of the owner task is tracked.
+   */
+  enum class Recursion
+  {
+    Native,     /** Each Lock() and Unlock() calls the native recursive mutex. */
+    OwnerCached /** The owner task and the recursion depth are cached, only the outermost Lock() and Unlock() call the native mutex. */
+  };
+
   public:
   /**
    * The default constructor.
@@ -38,6 +57,24 @@ class RecursiveMutex
    */
   RecursiveMutex();
 
+  /**
+   * Creates the native RTOS mutex with the given recursion mode.
+   * With Recursion::OwnerCached, a re-entry or an inner unlock by the owner task is a plain integer update,
+   * i.e. it does not enter the kernel critical section of the native recursive mutex.
+   * @param[in] recursion The recursion mode.
+   * @note Call IsValid() to verify if the mutex was created successfully.
+   */
+  explicit RecursiveMutex(Recursion recursion);
+
+  /**
+   * Defers creating the native RTOS mutex until the first call of Lock(), TryLock() or TryLockFor().
+   * Concurrent first calls are resolved atomically, exactly one native mutex is kept.
+   * @param[in] recursion The recursion mode.
+   * @note Use IsCreated() to check whether the native mutex has been created already.
+   *       If the creation fails, it is not retried: IsValid() returns false, TryLock() fails and Lock() asserts.
+   */
+  explicit RecursiveMutex(LazyCreate, Recursion recursion = Recursion::Native);
+
   /**
    * @brief Take and destroy the mutex handle.
    */
@@ -45,10 +82,21 @@ class RecursiveMutex
 
   public:
   /**
-   * @returns true if the mutex was created successfully, false otherwise.
+   * @returns true if the mutex was created successfully or if its creation is deferred to the first use (LazyCreate), false otherwise.
+   *          false as well, once the deferred creation has failed.
    */
   bool IsValid() const;
 
+  /**
+   * @returns true if the native mutex has been created, false if its creation is still deferred or has failed.
+   */
+  bool IsCreated() const;
+
+  /**
+   * @returns the recursion mode.
+   */
+  Recursion GetRecursion() const;
+
   /**
    * @brief Locks the mutex.
    * Blocks until mutex is available.
@@ -70,6 +118,18 @@ class RecursiveMutex
    */
   bool TryLockFor(rtos::Ticks_t timeout);
 
+  /**
+   * @brief Tries to lock the mutex.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
   /**
    * @brief Unlocks the mutex.
    */
@@ -82,9 +142,38 @@ class RecursiveMutex
 
   private:
   using NativeHdl = void*;
-  NativeHdl _handle; /** The native mutex handle managed by an instance of this class. */
+
+  /**
+   * @returns the native mutex handle, creates the native mutex if its creation was deferred.
+   */
+  NativeHdl GetHandle();
+
+  /**
+   * @brief Takes the native mutex.
+   * @param[in] timeout maximum time to block until.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  bool Take(rtos::Ticks_t timeout);
+
+  /**
+   * @brief Gives the native mutex.
+   */
+  void Give();
+
+  private:
+  std::atomic<NativeHdl> _handle; /** The native mutex handle managed by an instance of this class. */
+  bool _lazy; /** True if the native mutex is created on first use. */
+  std::atomic<bool> _createFailed; /** True if the deferred creation of the native mutex has failed. */
+  Recursion _recursion; /** The recursion mode. */
+  std::atomic<void*> _owner; /** The task owning the mutex in Recursion::OwnerCached mode, nullptr if not locked. */
+  uint32_t _depth; /** The recursion depth in Recursion::OwnerCached mode, only accessed by the owner task. */
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  rtos::LockStatsRecord _lockStats; /** The contention statistics of this mutex. */
+#endif
 };
 
+} // namespace KERNELAPI_LOCK_STATS_ABI
+
 } // namespace rtos
 
 #endif // HEADER_C0465C280F6C424C96B2A59E5D2195B9
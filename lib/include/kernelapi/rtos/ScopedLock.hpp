@@ -0,0 +1,243 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_61D6BCF4361E465DBDAC2A2561D74D32
+#define HEADER_61D6BCF4361E465DBDAC2A2561D74D32
+
+#include <cstddef>
+#include <tuple>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/MutexTraits.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+namespace detail
+{
+
+constexpr size_t lockSucceeded = static_cast<size_t>(-1);
+constexpr size_t lockTimedOut = static_cast<size_t>(-2);
+
+/**
+ * @brief Blocks on the mutex with index \a first and then tries to lock all other mutexes without blocking.
+ *        If one of the other mutexes is not available, all mutexes locked so far are unlocked again.
+ * @returns lockSucceeded if all mutexes are locked, lockTimedOut if \a first could not be locked within the timeout,
+ *          otherwise the index of the mutex which was not available.
+ */
+template <typename... MUTEXES>
+size_t LockFirstTryOthers(size_t first, rtos::Ticks_t timeout, MUTEXES&... mutexes)
+{
+  constexpr size_t count = sizeof...(MUTEXES);
+  bool locked[count] = {};
+  size_t failed {lockSucceeded};
+  size_t index {0};
+
+  auto lockFirst = [&](auto& mutex)
+  {
+    if (index == first)
+    {
+      locked[index] = mutex.TryLockFor(timeout);
+      failed = locked[index] ? lockSucceeded : lockTimedOut;
+    }
+    ++index;
+  };
+
+  auto tryOthers = [&](auto& mutex)
+  {
+    if ((index != first) && (lockSucceeded == failed))
+    {
+      locked[index] = mutex.TryLock();
+      failed = locked[index] ? lockSucceeded : index;
+    }
+    ++index;
+  };
+
+  auto unlock = [&](auto& mutex)
+  {
+    if (locked[index])
+    {
+      mutex.Unlock();
+    }
+    ++index;
+  };
+
+  (lockFirst(mutexes), ...);
+  if (lockSucceeded != failed)
+  {
+    return failed;
+  }
+
+  index = 0;
+  (tryOthers(mutexes), ...);
+  if (lockSucceeded != failed)
+  {
+    index = 0;
+    (unlock(mutexes), ...);
+  }
+
+  return failed;
+}
+
+} // namespace detail
+
+/**
+ * @brief Tries to lock the given mutex until the timeout has been reached.
+ * @param[in] timeout maximum time to block for.
+ * @param[in] mutex The mutex to lock.
+ * @returns true if the mutex was locked, false otherwise.
+ */
+template <typename MUTEX>
+bool TryLockFor(rtos::Ticks_t timeout, MUTEX& mutex)
+{
+  return mutex.TryLockFor(timeout);
+}
+
+/**
+ * @brief Tries to lock all given mutexes until the timeout has been reached, without risking a deadlock.
+ *        Blocks only on a single mutex while no other mutex is held. If another mutex is not available, all mutexes are unlocked
+ *        and the algorithm blocks on the unavailable mutex next (try-and-back-off).
+ * @param[in] timeout maximum time to block for.
+ * @param[in] mutexes The mutexes to lock, in any order.
+ * @returns true if all mutexes were locked, false if none of the mutexes is locked.
+ */
+template <typename MUTEX1, typename MUTEX2, typename... MUTEXES>
+bool TryLockFor(rtos::Ticks_t timeout, MUTEX1& mutex1, MUTEX2& mutex2, MUTEXES&... mutexes)
+{
+  TimeOut_t timeOutState;
+  TickType_t remaining {timeout};
+  size_t first {0};
+
+  vTaskSetTimeOutState(&timeOutState);
+
+  while (true)
+  {
+    first = detail::LockFirstTryOthers(first, remaining, mutex1, mutex2, mutexes...);
+
+    if (detail::lockSucceeded == first)
+    {
+      return true;
+    }
+
+    // Updates the remaining time for the next attempt.
+    if ((detail::lockTimedOut == first) || (pdTRUE == xTaskCheckForTimeOut(&timeOutState, &remaining)))
+    {
+      return false;
+    }
+  }
+}
+
+/**
+ * @brief Locks all given mutexes without risking a deadlock, see TryLockFor().
+ * @param[in] mutexes The mutexes to lock, in any order.
+ * @note Does not return before all mutexes are locked.
+ */
+template <typename... MUTEXES>
+void Lock(MUTEXES&... mutexes)
+{
+  static_assert(0 < sizeof...(MUTEXES), "At least one mutex is required");
+
+  // Use while loop in case infinite wait is not implemented by the rtos port.
+  while (!rtos::TryLockFor(GetMaxDelay(), mutexes...))
+  {
+  }
+}
+
+/**
+ * @brief The class ScopedLock is a RAII-style wrapper for owning any number of mutexes for the duration of a scoped block.
+ *        The mutexes are locked by rtos::Lock() in the constructor without risking a deadlock, regardless of the order of the mutexes,
+ *        and released in the destructor.
+ *        The ScopedLock class is non-copyable.
+ * @note The ScopedLock was inspired by the C++17 implementation of scoped_lock.
+ */
+template <typename... MUTEXES>
+class ScopedLock
+{
+  static_assert((rtos::isTimedLockable<MUTEXES> && ...), "MUTEXES have to provide Lock(), TryLock(), TryLockFor() and Unlock(), see MutexTraits.hpp");
+
+  // Make this class non-copyable
+  public:
+  ScopedLock(const ScopedLock& other) = delete;
+  ScopedLock& operator=(const ScopedLock& other) = delete;
+
+  public:
+  /**
+   * Stores the references to the mutexes and locks all of them.
+   * @note Does not return before all mutexes are locked.
+   * @param[in] mutexes References of the mutexes to be stored.
+   */
+  explicit ScopedLock(MUTEXES&... mutexes) :
+    _mutexes(mutexes...)
+  {
+    rtos::Lock(mutexes...);
+  }
+
+  /**
+   * Unlocks all mutexes.
+   */
+  ~ScopedLock()
+  {
+    std::apply([](auto&... mutexes) { (mutexes.Unlock(), ...); }, _mutexes);
+  }
+
+  private:
+  std::tuple<MUTEXES&...> _mutexes;
+};
+
+/**
+ * @brief The specialization of ScopedLock for a single mutex just locks and unlocks the mutex.
+ */
+template <typename MUTEX>
+class ScopedLock<MUTEX>
+{
+  static_assert(rtos::isBasicLockable<MUTEX>, "MUTEX has to provide Lock() and Unlock(), see MutexTraits.hpp");
+
+  // Make this class non-copyable
+  public:
+  ScopedLock(const ScopedLock& other) = delete;
+  ScopedLock& operator=(const ScopedLock& other) = delete;
+
+  public:
+  /**
+   * Stores a reference to mutex and invokes mutex.Lock() for locking the mutex.
+   * @note Does not return before the mutex was locked.
+   * @param[in] mutex Reference of the mutex to be stored.
+   */
+  explicit ScopedLock(MUTEX& mutex) :
+    _mutex(mutex)
+  {
+    _mutex.Lock();
+  }
+
+  /**
+   * Unlocks the mutex.
+   */
+  ~ScopedLock()
+  {
+    _mutex.Unlock();
+  }
+
+  private:
+  MUTEX& _mutex;
+};
+
+/**
+ * @brief The specialization of ScopedLock without any mutex does nothing.
+ */
+template <>
+class ScopedLock<>
+{
+  public:
+  ScopedLock() = default;
+  ScopedLock(const ScopedLock& other) = delete;
+  ScopedLock& operator=(const ScopedLock& other) = delete;
+};
+
+} // namespace rtos
+
+#endif // HEADER_61D6BCF4361E465DBDAC2A2561D74D32
@@ -0,0 +1,180 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_23DD27F4F11547B0A90F1135452FED56
+#define HEADER_23DD27F4F11547B0A90F1135452FED56
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <kernelapi/rtos/CacheLine.hpp>
+#include <kernelapi/rtos/MutexTraits.hpp>
+#include <kernelapi/rtos/SpinLock.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The SeqLock class shares small, frequently read and rarely written data between tasks and cores.
+ *        Readers do not write any shared memory, they copy the value and retry when a write happened meanwhile (torn read).
+ *        Thus readers never block a writer and do not bounce the cache line between the cores.
+ *        Writers are serialized by the \a LOCK and increment a sequence counter before and after updating the value.
+ *
+ * @note The default SpinLock disables the interrupts while writing, thus a reader never preempts a writer on the same core.
+ *       When using a blocking LOCK, e.g. rtos::Mutex, a reader with a higher priority on the core of a preempted writer
+ *       spins until the writer continues, do not read from an ISR or from higher priority tasks in that case.
+ * @note Read() and TryRead() may be called from an ISR, Write() and Modify() must not.
+ *
+ * @tparam T The type of the value, it has to be trivially copyable.
+ * @tparam LOCK The lock which serializes the writers.
+ */
+template <typename T, typename LOCK = rtos::SpinLock>
+class alignas(rtos::cacheLineSize) SeqLock
+{
+  static_assert(std::is_trivially_copyable_v<T>, "SeqLock requires a trivially copyable type T");
+  static_assert(rtos::isBasicLockable<LOCK>, "LOCK has to provide Lock() and Unlock(), see MutexTraits.hpp");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "The SeqLock needs lock-free atomics");
+
+  // Make this class non-copyable
+  public:
+  SeqLock(const SeqLock& other) = delete;
+  SeqLock& operator=(const SeqLock& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] value The initial value.
+   */
+  explicit SeqLock(const T& value = T{}) :
+    _sequence{0},
+    _words{},
+    _lock{}
+  {
+    Store(value);
+  }
+
+  public:
+  /**
+   * @brief Reads the value, retries until a consistent copy has been read.
+   * @returns a copy of the value.
+   */
+  T Read() const
+  {
+    T value;
+    while (!TryRead(value))
+    {
+    }
+    return value;
+  }
+
+  /**
+   * @brief Tries to read the value once.
+   * @param[out] value The copy of the value, only valid if true is returned.
+   * @returns true if a consistent copy has been read, false if a write was in progress.
+   */
+  bool TryRead(T& value) const
+  {
+    const uint32_t sequence = _sequence.load(std::memory_order_acquire);
+
+    if (0 != (sequence & 1U))
+    {
+      return false;
+    }
+
+    Load(value);
+
+    // Order the reads of the value before the second read of the sequence.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (sequence == _sequence.load(std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Writes the value.
+   * @param[in] value The new value.
+   */
+  void Write(const T& value)
+  {
+    _lock.Lock();
+    BeginWrite();
+    Store(value);
+    EndWrite();
+    _lock.Unlock();
+  }
+
+  /**
+   * @brief Modifies the value in place, e.g. to update a single member.
+   * @param[in] modifier The callable, which is called with a T& of the current value while the writers are locked.
+   */
+  template <typename MODIFIER>
+  void Modify(MODIFIER&& modifier)
+  {
+    _lock.Lock();
+    T value;
+    Load(value);
+    modifier(value);
+    BeginWrite();
+    Store(value);
+    EndWrite();
+    _lock.Unlock();
+  }
+
+  /**
+   * @returns the sequence counter, it changes with each write and is odd while a write is in progress.
+   */
+  uint32_t GetSequence() const
+  {
+    return _sequence.load(std::memory_order_acquire);
+  }
+
+  private:
+  void BeginWrite()
+  {
+    const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1U, std::memory_order_relaxed);
+
+    // Order the odd sequence before the writes of the value.
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  void EndWrite()
+  {
+    const uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+    _sequence.store(sequence + 1U, std::memory_order_release);
+  }
+
+  // The value is copied word by word with relaxed atomics, thus a concurrent read is not a data race.
+  void Load(T& value) const
+  {
+    uint32_t words[wordCount];
+    for (size_t i = 0; i < wordCount; ++i)
+    {
+      words[i] = _words[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&value, words, sizeof(T));
+  }
+
+  void Store(const T& value)
+  {
+    uint32_t words[wordCount] {};
+    std::memcpy(words, &value, sizeof(T));
+    for (size_t i = 0; i < wordCount; ++i)
+    {
+      _words[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  private:
+  static constexpr size_t wordCount {(sizeof(T) + sizeof(uint32_t) - 1U) / sizeof(uint32_t)};
+
+  std::atomic<uint32_t> _sequence;         /** The sequence counter, odd while a write is in progress. */
+  std::atomic<uint32_t> _words[wordCount]; /** The value, stored as words. */
+  LOCK _lock;                              /** The lock which serializes the writers. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_23DD27F4F11547B0A90F1135452FED56
@@ -0,0 +1,183 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_236BC14E8BE846DFA5A4103BC79C585F
+#define HEADER_236BC14E8BE846DFA5A4103BC79C585F
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/MutexTraits.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The class SharedLockGuard is a RAII-style wrapper for owning a shared mutex in shared mode for the duration of a scoped block.
+ *        When a SharedLockGuard object is created, it attempts to take shared ownership of the mutex it is given. When control leaves the scope in
+ *        which the SharedLockGuard object was created, the SharedLockGuard is destructed and the shared ownership is released.
+ *        Use LockGuard to own a shared mutex in exclusive mode.
+ *        The SharedLockGuard class is non-copyable.
+ * @note The MUTEX type has to provide LockShared(), TryLockShared(), TryLockSharedFor() and UnlockShared(), e.g. SharedMutex.
+ */
+template <typename MUTEX>
+class SharedLockGuard
+{
+  static_assert(rtos::isSharedLockable<MUTEX>, "MUTEX has to provide LockShared(), TryLockShared(), TryLockSharedFor() and UnlockShared(), see MutexTraits.hpp");
+
+  // Make this class non-copyable
+  public:
+  SharedLockGuard(const SharedLockGuard& other) = delete;
+  SharedLockGuard& operator=(const SharedLockGuard& other) = delete;
+
+  public:
+
+  /**
+   * Stores a reference to mutex and invokes mutex.LockShared() for locking the mutex in shared mode.
+   * @note Does not return before the mutex was locked.
+   * @param[in] mutex Reference of the mutex to be stored.
+   */
+  explicit SharedLockGuard(MUTEX& mutex) :
+    _mutex(mutex), _isLocked(false)
+  {
+    Lock();
+  }
+
+  /**
+   * Stores a reference to mutex but does not lock the mutex.
+   *        The mutex can be locked by the methods Lock(), TryLock() or TryLockFor()
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @note DeferLock tag parameter is used to select non-locking version of the constructor.
+   */
+  SharedLockGuard(MUTEX& mutex, DeferLock) noexcept :
+    _mutex(mutex), _isLocked(false)
+  {}
+
+  /**
+   * Stores the reference to the given mutex and tries to lock the mutex in shared mode.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @note TryToLock tag parameter used to select try-lock version of the constructor.
+   * @note Returns immediately, even if the mutex was not locked! You can call OwnsLock() to verify if the mutex was locked.
+   */
+  SharedLockGuard(MUTEX& mutex, TryToLock) :
+    _mutex(mutex), _isLocked(false)
+  {
+    TryLock();
+  }
+
+  /**
+   * Stores the reference to the given mutex and tries to lock it in shared mode.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @param[in] timeout maximum time to block for.
+   * @note To verify the mutex was locked, call OwnsLock()
+   */
+  SharedLockGuard(MUTEX& mutex, rtos::Ticks_t timeout) :
+    _mutex(mutex), _isLocked(false)
+  {
+    TryLockFor(timeout);
+  }
+
+  /**
+   * Stores the reference to the given mutex and tries to lock it in shared mode.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @param[in] timeout maximum duration to block for, rounded up to the next tick.
+   * @note To verify the mutex was locked, call OwnsLock()
+   */
+  template <typename REP, typename PERIOD>
+  SharedLockGuard(MUTEX& mutex, const std::chrono::duration<REP, PERIOD>& timeout) :
+    SharedLockGuard(mutex, rtos::ToTicks(timeout))
+  {}
+
+  /**
+   * Unlocks the mutex, when it owns the shared lock.
+   */
+  ~SharedLockGuard()
+  {
+    Unlock();
+  }
+
+  /**
+   * Lock the mutex in shared mode, wait until mutex is available.
+   */
+  void Lock()
+  {
+    if (!OwnsLock())
+    {
+      _mutex.LockShared();
+      _isLocked = true;
+    }
+  }
+
+  /**
+   * Tries to lock the mutex in shared mode, does not wait if the mutex is not available.
+   * @returns true if it owns the shared lock, false otherwise.
+   */
+  bool TryLock()
+  {
+    if (!OwnsLock())
+    {
+      _isLocked = _mutex.TryLockShared();
+    }
+
+    return _isLocked;
+  }
+
+  /**
+   * Tries to lock the mutex in shared mode.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] timeout maximum time to block for.
+   * @returns true, if it owns the shared lock, false otherwise.
+   */
+  bool TryLockFor(rtos::Ticks_t timeout)
+  {
+    if (!OwnsLock())
+    {
+      _isLocked = _mutex.TryLockSharedFor(timeout);
+    }
+
+    return _isLocked;
+  }
+
+  /**
+   * Tries to lock the mutex in shared mode.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] timeout maximum duration to block for, rounded up to the next tick.
+   * @returns true, if it owns the shared lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * Unlock the mutex, if it was locked in shared mode before.
+   */
+  void Unlock() noexcept
+  {
+    if (OwnsLock())
+    {
+      _isLocked = false;
+      _mutex.UnlockShared();
+    }
+  }
+
+  /**
+   * @returns true, when it owns the shared lock, false otherwise.
+   */
+  bool OwnsLock() const noexcept
+  {
+    return _isLocked;
+  }
+
+  private:
+  MUTEX& _mutex;
+  bool _isLocked;
+};
+
+} // namespace rtos
+
+#endif // HEADER_236BC14E8BE846DFA5A4103BC79C585F
@@ -0,0 +1,170 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_2F4E9C3CE0C94603BDA07BB03946487A
+#define HEADER_2F4E9C3CE0C94603BDA07BB03946487A
+
+#include <cstdint>
+
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+// The layout depends on KERNELAPI_ENABLE_LOCK_STATS by the embedded Mutex, see LockStats.hpp.
+inline namespace KERNELAPI_LOCK_STATS_ABI
+{
+
+/**
+ * @brief The SharedMutex class is a reader/writer lock: Multiple tasks can own the lock in shared mode for reading,
+ *        while only one task can own the lock in exclusive mode for writing.
+ *        Use the SharedMutex for data which is read by many tasks and written rarely, the readers do not serialize each other.
+ *
+ * @note The SharedMutex is built of a counting semaphore with one token per reader and a Mutex which serializes the writers.
+ *       A writer owns the lock in exclusive mode when it has taken all tokens.
+ *       With Preference::Writers, readers have to pass the writer mutex as well, so a waiting writer blocks new readers and is not starved.
+ *       With Preference::Readers, readers bypass the writer mutex, so readers are never delayed by waiting writers.
+ *
+ * @note Priority inheritance applies only to the writer mutex, but not to the tasks holding a shared lock.
+ * @note The lock is non-recursive in both modes. Do not call the mutex methods within an ISR!
+ */
+class SharedMutex
+{
+  // Make this class non-copyable
+  public:
+  SharedMutex(const SharedMutex& other) = delete;
+  SharedMutex& operator=(const SharedMutex& other) = delete;
+
+  public:
+  /**
+   * @brief Selects who is preferred, when readers and writers are waiting.
+   */
+  enum class Preference
+  {
+    Readers, /** Readers are never delayed by waiting writers, writers may starve. */
+    Writers  /** A waiting writer blocks new readers. */
+  };
+
+  /**
+   * The default maximum number of tasks, which can own the lock in shared mode at the same time.
+   */
+  static constexpr uint32_t defaultMaxReaders {8};
+
+  /**
+   * The constructor.
+   * Creates the native RTOS objects and stores the handles to them.
+   * @param[in] maxReaders maximum number of tasks, which can own the lock in shared mode at the same time.
+   *            Writers take one token per reader, so keep this number small.
+   * @param[in] preference selects who is preferred, when readers and writers are waiting.
+   * @note Call IsValid() to verify if the mutex was created successfully.
+   */
+  explicit SharedMutex(uint32_t maxReaders = defaultMaxReaders, Preference preference = Preference::Writers);
+
+  /**
+   * @brief Destroy the native handles.
+   */
+  virtual ~SharedMutex();
+
+  public:
+  /**
+   * @returns true if the mutex was created successfully, false otherwise.
+   */
+  bool IsValid() const;
+
+  /**
+   * @brief Locks the mutex in exclusive mode.
+   * Blocks until the mutex is available.
+   */
+  void Lock();
+
+  /**
+   * @brief Tries to lock the mutex in exclusive mode, does not block if the mutex is not available.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLock();
+
+  /**
+   * @brief Tries to lock the mutex in exclusive mode.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  bool TryLockFor(rtos::Ticks_t timeout);
+
+  /**
+   * @brief Tries to lock the mutex in exclusive mode.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Unlocks the mutex, which was locked in exclusive mode.
+   */
+  void Unlock();
+
+  /**
+   * @brief Locks the mutex in shared mode.
+   * Blocks until the mutex is available.
+   */
+  void LockShared();
+
+  /**
+   * @brief Tries to lock the mutex in shared mode, does not block if the mutex is not available.
+   * @returns true if it owns the shared lock, false otherwise.
+   */
+  bool TryLockShared();
+
+  /**
+   * @brief Tries to lock the mutex in shared mode.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true, if it owns the shared lock, false otherwise.
+   */
+  bool TryLockSharedFor(rtos::Ticks_t timeout);
+
+  /**
+   * @brief Tries to lock the mutex in shared mode.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true, if it owns the shared lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockSharedFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockSharedFor(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Unlocks the mutex, which was locked in shared mode.
+   */
+  void UnlockShared();
+
+  private:
+  /**
+   * @brief Gives back the given number of reader tokens.
+   * @param[in] count number of tokens to give back.
+   */
+  void GiveTokens(uint32_t count);
+
+  private:
+  using NativeHdl = void*;
+  rtos::Mutex _writerMutex;     /** Serializes the writers, and with Preference::Writers the readers too. */
+  NativeHdl _tokens;            /** The native counting semaphore with one token per reader. */
+  const uint32_t _maxReaders;   /** The number of reader tokens. */
+  const Preference _preference; /** Selects who is preferred, when readers and writers are waiting. */
+};
+
+} // namespace KERNELAPI_LOCK_STATS_ABI
+
+} // namespace rtos
+
+#endif // HEADER_2F4E9C3CE0C94603BDA07BB03946487A
@@ -0,0 +1,90 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_E54CA88E20B9460DB02D60DED5C81873
+#define HEADER_E54CA88E20B9460DB02D60DED5C81873
+
+#include <cassert>
+#include <cstddef>
+
+namespace rtos
+{
+
+/**
+ * @brief The Span class refers to a contiguous sequence of objects owned by someone else, e.g. a part of a ring buffer.
+ *        It is a minimal replacement of std::span, which is not available in C++17.
+ *
+ * @tparam T The type of the objects, use a const type for read-only access.
+ */
+template <typename T>
+class Span
+{
+  public:
+  /**
+   * The default constructor.
+   * Creates an empty span.
+   */
+  constexpr Span() = default;
+
+  /**
+   * The constructor.
+   * @param[in] data The first object.
+   * @param[in] size The number of objects.
+   */
+  constexpr Span(T* data, size_t size) :
+    _data{data},
+    _size{size}
+  {}
+
+  public:
+  /**
+   * @returns the pointer to the first object.
+   */
+  constexpr T* GetData() const
+  {
+    return _data;
+  }
+
+  /**
+   * @returns the number of objects.
+   */
+  constexpr size_t GetSize() const
+  {
+    return _size;
+  }
+
+  /**
+   * @returns true if the span does not refer to any object.
+   */
+  constexpr bool IsEmpty() const
+  {
+    return (0 == _size);
+  }
+
+  constexpr T& operator[](size_t index) const
+  {
+    assert((index < _size) && "Span index out of range");
+    return _data[index];
+  }
+
+  // Range based for loop support
+  constexpr T* begin() const
+  {
+    return _data;
+  }
+
+  constexpr T* end() const
+  {
+    return _data + _size;
+  }
+
+  private:
+  T* _data {nullptr}; /** The first object. */
+  size_t _size {0};   /** The number of objects. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_E54CA88E20B9460DB02D60DED5C81873
@@ -0,0 +1,181 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_36DE27D87DB047E4B3195110B1FB1F7C
+#define HEADER_36DE27D87DB047E4B3195110B1FB1F7C
+
+#if defined(KERNELAPI_BACKEND_HOST)
+  #include <atomic>
+  #include <cstdint>
+  #include <thread>
+#else
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/task.h>
+#endif
+
+namespace rtos
+{
+
+/**
+ * @brief The SpinLock class protects very short critical sections, which are shared between the cores of a multi-core (SMP) target.
+ *        Locking the SpinLock disables the interrupts of the calling core and spins until the other core released the lock.
+ *        Compared to the Mutex class no kernel object is involved, thus there is no priority inheritance and no context switch.
+ *
+ * @note The SpinLock class is a wrapper class for the portMUX_TYPE spinlock of the ESP-IDF FreeRTOS port.
+ *       See https://docs.espressif.com/projects/esp-idf/en/stable/esp32/api-reference/system/freertos_idf.html#critical-sections
+ *       The SpinLock is recursive on the same core, i.e. it must be unlocked as often as it was locked.
+ *
+ * @note Keep the locked section as short as possible and do not call any blocking RTOS functions while the lock is held!
+ * @note Use the FromISR methods when called within an ISR.
+ * @note The host backend spins on an atomic owner instead, the SpinLock is recursive on the same thread.
+ */
+class SpinLock final
+{
+  // Make this class non-copyable
+  public:
+  SpinLock(const SpinLock& other) = delete;
+  SpinLock& operator=(const SpinLock& other) = delete;
+
+  public:
+  /**
+   * The default constructor.
+   * Initializes the spinlock in unlocked state, no kernel object is created.
+   */
+  constexpr SpinLock() = default;
+
+#if defined(KERNELAPI_BACKEND_HOST)
+  // The host backend, see the FreeRTOS backend below for the documentation of the methods.
+  public:
+  void Lock()
+  {
+    const uintptr_t self = GetThreadTag();
+    if (self == _owner.load(std::memory_order_relaxed))
+    {
+      ++_depth;
+      return;
+    }
+
+    uintptr_t expected {0};
+    while (!_owner.compare_exchange_weak(expected, self, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      expected = 0;
+      std::this_thread::yield();
+    }
+    _depth = 1;
+  }
+
+  bool TryLock()
+  {
+    const uintptr_t self = GetThreadTag();
+    if (self == _owner.load(std::memory_order_relaxed))
+    {
+      ++_depth;
+      return true;
+    }
+
+    uintptr_t expected {0};
+    if (!_owner.compare_exchange_strong(expected, self, std::memory_order_acquire, std::memory_order_relaxed))
+    {
+      return false;
+    }
+    _depth = 1;
+    return true;
+  }
+
+  void Unlock()
+  {
+    if (0 == --_depth)
+    {
+      _owner.store(0, std::memory_order_release);
+    }
+  }
+
+  void LockFromISR()
+  {
+    Lock();
+  }
+
+  bool TryLockFromISR()
+  {
+    return TryLock();
+  }
+
+  void UnlockFromISR()
+  {
+    Unlock();
+  }
+
+  private:
+  // Returns a unique non-zero value of the calling thread.
+  static uintptr_t GetThreadTag()
+  {
+    static thread_local const char tag {0};
+    return reinterpret_cast<uintptr_t>(&tag);
+  }
+
+  private:
+  std::atomic<uintptr_t> _owner {0}; /** The tag of the thread holding the lock, 0 if not locked. */
+  uint32_t _depth {0};               /** The recursion depth, only accessed by the owner thread. */
+#else
+  public:
+  /**
+   * @brief Locks the spinlock.
+   * Disables the interrupts of the calling core and spins until the spinlock is available.
+   */
+  void Lock()
+  {
+    taskENTER_CRITICAL(&_mux);
+  }
+
+  /**
+   * @brief Tries to lock the spinlock, does not spin if the spinlock is held by the other core.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLock()
+  {
+    return (pdPASS == portTRY_ENTER_CRITICAL(&_mux, portMUX_TRY_LOCK));
+  }
+
+  /**
+   * @brief Unlocks the spinlock and restores the interrupts of the calling core.
+   */
+  void Unlock()
+  {
+    taskEXIT_CRITICAL(&_mux);
+  }
+
+  /**
+   * @brief Locks the spinlock from within an ISR.
+   */
+  void LockFromISR()
+  {
+    taskENTER_CRITICAL_ISR(&_mux);
+  }
+
+  /**
+   * @brief Tries to lock the spinlock from within an ISR, does not spin if the spinlock is held by the other core.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLockFromISR()
+  {
+    return (pdPASS == portTRY_ENTER_CRITICAL_ISR(&_mux, portMUX_TRY_LOCK));
+  }
+
+  /**
+   * @brief Unlocks the spinlock from within an ISR.
+   */
+  void UnlockFromISR()
+  {
+    taskEXIT_CRITICAL_ISR(&_mux);
+  }
+
+  private:
+  portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED; /** The native spinlock. */
+#endif
+};
+
+} // namespace rtos
+
+#endif // HEADER_36DE27D87DB047E4B3195110B1FB1F7C
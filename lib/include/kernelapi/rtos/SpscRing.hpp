@@ -0,0 +1,264 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A7F55FC87E7D4754A06584C94731DAA5
+#define HEADER_A7F55FC87E7D4754A06584C94731DAA5
+
+#include <atomic>
+#include <cstddef>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/CacheLine.hpp>
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The SpscRing class is a lock-free ring buffer for exactly one producer and exactly one consumer, e.g. an ISR and a task.
+ *        Push and pop do not call the kernel, they only use acquire/release atomics on the head and tail indices,
+ *        which are placed on separate cache lines.
+ *        Optionally the consumer task is woken up by a task notification, when the ring changes from empty to non-empty.
+ *
+ * @note Only one task or ISR may push and only one task or ISR may pop at a time!
+ * @note The wakeup uses the task notification (index 0) of the consumer task, do not use it for another purpose.
+ *
+ * @tparam T The type of the items.
+ * @tparam N The capacity, must be a power of two.
+ */
+template <typename T, size_t N>
+class SpscRing
+{
+  static_assert((1 < N) && (0 == (N & (N - 1))), "The capacity N has to be a power of two");
+  static_assert(std::atomic<size_t>::is_always_lock_free, "The ring needs lock-free atomics");
+
+  // Make this class non-copyable
+  public:
+  SpscRing(const SpscRing& other) = delete;
+  SpscRing& operator=(const SpscRing& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] consumer The task to be notified, when the ring changes from empty to non-empty, nullptr disables the wakeup.
+   */
+  explicit SpscRing(TaskHandle_t consumer = nullptr) :
+    _head{0},
+    _tail{0},
+    _consumer{consumer},
+    _buffer{}
+  {}
+
+  public:
+  /**
+   * @brief Sets the task to be notified, when the ring changes from empty to non-empty.
+   * @param[in] consumer The consumer task, nullptr disables the wakeup.
+   */
+  void SetConsumer(TaskHandle_t consumer)
+  {
+    _consumer.store(consumer, std::memory_order_release);
+  }
+
+  /**
+   * @returns the number of items the ring can hold.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return N;
+  }
+
+  /**
+   * @returns the number of items in the ring, the value may be outdated when the other side is active.
+   */
+  size_t GetCount() const
+  {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @returns true if the ring does not contain any item.
+   */
+  bool IsEmpty() const
+  {
+    return (0 == GetCount());
+  }
+
+  /**
+   * @brief Copies the item into the ring, to be called by the producer task.
+   * @param[in] item The item to be copied.
+   * @returns true if the item was pushed, false if the ring is full.
+   */
+  bool Push(const T& item)
+  {
+    return (1 == PushN(&item, 1));
+  }
+
+  /**
+   * @brief Copies up to \a count items into the ring, to be called by the producer task.
+   * @param[in] items The items to be copied.
+   * @param[in] count The number of items.
+   * @returns the number of pushed items, which is less than \a count if the ring is full.
+   */
+  size_t PushN(const T* items, size_t count)
+  {
+    size_t head {0};
+    const size_t pushed = Write(items, count, head);
+    if (ConsumerMayWait(head, pushed))
+    {
+      xTaskNotifyGive(_consumer.load(std::memory_order_acquire));
+    }
+
+    return pushed;
+  }
+
+  /**
+   * @brief Copies the item into the ring, to be called by the producer ISR.
+   * @param[in] item The item to be copied.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if the wakeup unblocked a task of higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns true if the item was pushed, false if the ring is full.
+   */
+  bool PushFromISR(const T& item, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    return (1 == PushNFromISR(&item, 1, higherPriorityTaskWoken));
+  }
+
+  /**
+   * @brief Copies up to \a count items into the ring, to be called by the producer ISR.
+   * @param[in] items The items to be copied.
+   * @param[in] count The number of items.
+   * @param[out] higherPriorityTaskWoken See PushFromISR().
+   * @returns the number of pushed items, which is less than \a count if the ring is full.
+   */
+  size_t PushNFromISR(const T* items, size_t count, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    size_t head {0};
+    const size_t pushed = Write(items, count, head);
+    if (ConsumerMayWait(head, pushed))
+    {
+      BaseType_t woken {pdFALSE};
+      vTaskNotifyGiveFromISR(_consumer.load(std::memory_order_acquire), &woken);
+
+      detail::YieldFromISR(woken, higherPriorityTaskWoken);
+    }
+
+    return pushed;
+  }
+
+  /**
+   * @brief Takes the oldest item out of the ring, to be called by the consumer.
+   * @param[out] item The item.
+   * @returns true if an item was popped, false if the ring is empty.
+   */
+  bool Pop(T& item)
+  {
+    return (1 == PopN(&item, 1));
+  }
+
+  /**
+   * @brief Takes up to \a count of the oldest items out of the ring, to be called by the consumer.
+   * @param[out] items The buffer for the items.
+   * @param[in] count The number of items the buffer can hold.
+   * @returns the number of popped items.
+   */
+  size_t PopN(T* items, size_t count)
+  {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    const size_t available = _head.load(std::memory_order_acquire) - tail;
+    const size_t popped = (count < available) ? count : available;
+
+    for (size_t i = 0; i < popped; ++i)
+    {
+      items[i] = _buffer[(tail + i) & mask];
+    }
+
+    _tail.store(tail + popped, std::memory_order_release);
+    return popped;
+  }
+
+  /**
+   * @brief Waits until the ring contains at least one item, to be called by the consumer task set by SetConsumer().
+   * If the ring is empty, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the ring contains an item, false if the timeout has been reached.
+   */
+  bool WaitForData(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    TimeOut_t timeOutState;
+    TickType_t remaining {timeout};
+    vTaskSetTimeOutState(&timeOutState);
+
+    // Pairs with the fence of the producer, so either the producer sees the ring empty and notifies or we see the new item.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    while (IsEmpty())
+    {
+      // A notification may be left over from items, which were already popped. Then check again.
+      if ((0 == ulTaskNotifyTake(pdTRUE, remaining)) ||
+          (pdTRUE == xTaskCheckForTimeOut(&timeOutState, &remaining)))
+      {
+        return !IsEmpty();
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Waits until the ring contains at least one item, to be called by the consumer task set by SetConsumer().
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the ring contains an item, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool WaitForData(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return WaitForData(rtos::ToTicks(timeout));
+  }
+
+  private:
+  static constexpr size_t mask {N - 1};
+
+  // Copies the items and returns the number of pushed items, \a head is set to the head before the write.
+  size_t Write(const T* items, size_t count, size_t& head)
+  {
+    head = _head.load(std::memory_order_relaxed);
+    const size_t space = N - (head - _tail.load(std::memory_order_acquire));
+    const size_t pushed = (count < space) ? count : space;
+
+    for (size_t i = 0; i < pushed; ++i)
+    {
+      _buffer[(head + i) & mask] = items[i];
+    }
+
+    _head.store(head + pushed, std::memory_order_release);
+    return pushed;
+  }
+
+  // Returns true if the consumer had popped all items before the write at \a head, so it may wait for a notification.
+  bool ConsumerMayWait(size_t head, size_t pushed)
+  {
+    if ((0 == pushed) || (nullptr == _consumer.load(std::memory_order_relaxed)))
+    {
+      return false;
+    }
+
+    // Pairs with the fence in WaitForData().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return (_tail.load(std::memory_order_relaxed) == head);
+  }
+
+  private:
+  alignas(rtos::cacheLineSize) std::atomic<size_t> _head; /** The index of the next item to be pushed, written by the producer. */
+  alignas(rtos::cacheLineSize) std::atomic<size_t> _tail; /** The index of the next item to be popped, written by the consumer. */
+  std::atomic<TaskHandle_t> _consumer;                    /** The task to be notified, when the ring changes from empty to non-empty. */
+  alignas(rtos::cacheLineSize) T _buffer[N];              /** The items. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_A7F55FC87E7D4754A06584C94731DAA5
@@ -0,0 +1,107 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_C55F5EC61459451E8161CCDB8C7781F2
+#define HEADER_C55F5EC61459451E8161CCDB8C7781F2
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The StaticMutex class is a Mutex which embeds the memory of the native RTOS mutex.
+ *        Contrary to the Mutex class, no memory is allocated from the RTOS heap, thus creating the StaticMutex is deterministic and cannot fail.
+ *        The StaticMutex includes a priority inheritance mechanism for eliminating unbounded priority inversion.
+ *
+ * @note The StaticMutex class is a wrapper class for the native RTOS mutex implementation.
+ *       See https://www.freertos.org/xSemaphoreCreateMutexStatic.html for details.
+ *       Requires configSUPPORT_STATIC_ALLOCATION to be enabled in the RTOS configuration.
+ *
+ * @note  This StaticMutex class is non-recursive, see Mutex for details.
+ *        If you need to call a mutex recursive within a task, use StaticRecursiveMutex class instead.
+ *
+ * @note Do not call the mutex methods within an ISR!
+ * @note The StaticMutex is final and has no virtual methods, so a table of them, e.g. a StripedMutex, holds no vtable pointers.
+ */
+class StaticMutex final
+{
+  // Make this class non-copyable
+  public:
+  StaticMutex(const StaticMutex& other) = delete;
+  StaticMutex& operator=(const StaticMutex& other) = delete;
+
+  public:
+  /**
+   * The default constructor.
+   * Creates the native RTOS mutex within the embedded storage and stores the handle to it.
+   */
+  StaticMutex();
+
+  /**
+   * @brief Destroy the mutex handle.
+   */
+  ~StaticMutex();
+
+  public:
+  /**
+   * @returns true if the mutex was created successfully, false otherwise.
+   */
+  bool IsValid() const;
+
+  /**
+   * @brief Locks the mutex.
+   * Blocks until mutex is available.
+   * @note This method has no timeout, it waits until the mutex is available.
+   */
+  void Lock();
+
+  /**
+   * @brief Tries to lock the mutex, does not block if the mutex is not available.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLock();
+
+  /**
+   * @brief Tries to lock the mutex.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  bool TryLockFor(rtos::Ticks_t timeout);
+
+  /**
+   * @brief Tries to lock the mutex.
+   * If the mutex is not available, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Unlocks the mutex.
+   */
+  void Unlock();
+
+  /**
+   * @returns true when the mutex is locked
+   */
+  bool IsLocked();
+
+  private:
+  StaticSemaphore_t _storage; /** The memory of the native mutex. */
+  SemaphoreHandle_t _handle;  /** The native mutex handle managed by an instance of this class. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_C55F5EC61459451E8161CCDB8C7781F2
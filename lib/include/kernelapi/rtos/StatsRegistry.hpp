@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_4A1269F745A54A0083C4AA7135DF787E
+#define HEADER_4A1269F745A54A0083C4AA7135DF787E
+
+#include <cstdint>
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/SpinLock.hpp>
+
+namespace rtos
+{
+
+namespace detail
+{
+
+/**
+ * @brief The StatsRegistry class is an intrusive list of statistics records, e.g. of LockStatsRecord.
+ *        The list is protected by a SpinLock and the constructor is constexpr, so records can be registered during static initialization
+ *        and from any core, without allocating memory.
+ *
+ * @tparam RECORD The record type, it has to provide a member RECORD* _next, and the methods STATS GetStats() const and void Reset().
+ * @tparam STATS The statistics type copied out of the records.
+ */
+template <typename RECORD, typename STATS>
+class StatsRegistry
+{
+  // Make this class non-copyable
+  public:
+  StatsRegistry(const StatsRegistry& other) = delete;
+  StatsRegistry& operator=(const StatsRegistry& other) = delete;
+
+  public:
+  constexpr StatsRegistry() = default;
+
+  public:
+  void Register(RECORD& record)
+  {
+    LockGuard<SpinLock> guard {_lock};
+    record._next = _head;
+    _head = &record;
+  }
+
+  void Unregister(RECORD& record)
+  {
+    LockGuard<SpinLock> guard {_lock};
+    for (RECORD** it = &_head; nullptr != *it; it = &((*it)->_next))
+    {
+      if (&record == *it)
+      {
+        *it = record._next;
+        break;
+      }
+    }
+  }
+
+  /**
+   * @brief Copies the statistics of up to \a count records, starting with the record at index \a first.
+   * @returns the number of copied entries.
+   */
+  uint32_t Copy(STATS* buffer, uint32_t count, uint32_t first)
+  {
+    LockGuard<SpinLock> guard {_lock};
+    uint32_t index {0};
+    uint32_t copied {0};
+
+    for (const RECORD* it = _head; (nullptr != it) && (copied < count); it = it->_next, ++index)
+    {
+      if (index >= first)
+      {
+        buffer[copied++] = it->GetStats();
+      }
+    }
+
+    return copied;
+  }
+
+  void Reset()
+  {
+    LockGuard<SpinLock> guard {_lock};
+    for (RECORD* it = _head; nullptr != it; it = it->_next)
+    {
+      it->Reset();
+    }
+  }
+
+  private:
+  SpinLock _lock {};
+  RECORD* _head {nullptr};
+};
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_4A1269F745A54A0083C4AA7135DF787E
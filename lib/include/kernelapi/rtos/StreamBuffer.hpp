@@ -0,0 +1,334 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_E41FA3E2232F4E5A8DA0484E76C00D6A
+#define HEADER_E41FA3E2232F4E5A8DA0484E76C00D6A
+
+#include <cstddef>
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+
+#include <kernelapi/rtos/ByteRing.hpp>
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Span.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The StreamBuffer class passes a stream of bytes from a single writer to a single reader, e.g. from a UART ISR to a parser task.
+ *        The \a N bytes of the ring are embedded in the StreamBuffer, no memory is allocated from the RTOS heap.
+ *        Besides copying Send() and Receive() methods, the ring can be accessed in place:
+ *        the writer fills the span returned by Reserve() and publishes it by Commit(), e.g. as DMA target,
+ *        the reader parses the span returned by Peek() and releases it by Consume().
+ *        A reader blocked in Receive() or WaitForData() is woken up when the trigger level number of bytes is available.
+ *
+ * @note The semantic follows the native RTOS stream buffer, see https://www.freertos.org/RTOS-stream-buffer-API.html
+ *       Contrary to the native stream buffer the ring is exposed for in-place access, so the StreamBuffer is implemented lock-free
+ *       on top of acquire/release atomics instead of wrapping xStreamBufferCreateStatic.
+ *
+ * @note Only one task or ISR may write and only one task or ISR may read at a time!
+ * @note A blocked task is woken up by a task notification. If configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 the last notification index is used,
+ *       otherwise index 0, do not use it for another purpose in the writer and reader tasks.
+ * @note Use the FromISR methods when called within an ISR.
+ *
+ * @tparam N The capacity in bytes, must be a power of two.
+ */
+template <size_t N>
+class StreamBuffer
+{
+  // Make this class non-copyable
+  public:
+  StreamBuffer(const StreamBuffer& other) = delete;
+  StreamBuffer& operator=(const StreamBuffer& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] triggerLevel The number of bytes, which have to be available before a blocked reader is woken up.
+   */
+  explicit StreamBuffer(size_t triggerLevel = 1) :
+    _ring{},
+    _triggerLevel{1}
+  {
+    SetTriggerLevel(triggerLevel);
+  }
+
+  public:
+  /**
+   * @returns the number of bytes the stream buffer can hold.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return N;
+  }
+
+  /**
+   * @brief Sets the number of bytes, which have to be available before a blocked reader is woken up.
+   * @param[in] triggerLevel The trigger level in the range of 1 to GetCapacity(), 0 is treated as 1.
+   * @returns true if the trigger level was set, false if it exceeds the capacity.
+   */
+  bool SetTriggerLevel(size_t triggerLevel)
+  {
+    if (N < triggerLevel)
+    {
+      return false;
+    }
+
+    _triggerLevel = (0 == triggerLevel) ? 1 : triggerLevel;
+    return true;
+  }
+
+  /**
+   * @returns the trigger level.
+   */
+  size_t GetTriggerLevel() const
+  {
+    return _triggerLevel;
+  }
+
+  /**
+   * @brief Copies the bytes into the stream buffer, to be called by the writer task.
+   * If there is not enough space for all bytes, it blocks until specified timeout has been reached
+   * and then copies as many bytes as fit.
+   * @param[in] data The bytes to be copied.
+   * @param[in] size The number of bytes.
+   * @param[in] timeout maximum time to block until.
+   * @returns the number of bytes written.
+   */
+  size_t Send(const void* data, size_t size, rtos::Ticks_t timeout = 0)
+  {
+    _ring.WaitForSpaces(Min(size, N), timeout);
+    const size_t written = _ring.CopyIn(static_cast<const uint8_t*>(data), size);
+    _ring.Commit(written);
+    return written;
+  }
+
+  /**
+   * @brief Copies the bytes into the stream buffer, to be called by the writer task.
+   * @param[in] data The bytes to be copied.
+   * @param[in] size The number of bytes.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns the number of bytes written.
+   */
+  template <typename REP, typename PERIOD>
+  size_t Send(const void* data, size_t size, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Send(data, size, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Copies as many bytes as fit into the stream buffer from within an ISR.
+   * @param[in] data The bytes to be copied.
+   * @param[in] size The number of bytes.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if sending unblocked a task of higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns the number of bytes written.
+   */
+  size_t SendFromISR(const void* data, size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    const size_t written = _ring.CopyIn(static_cast<const uint8_t*>(data), size);
+    CommitFromISR(written, higherPriorityTaskWoken);
+    return written;
+  }
+
+  /**
+   * @brief Copies up to \a size bytes out of the stream buffer, to be called by the reader task.
+   * If less than the trigger level number of bytes is available, it blocks until specified timeout has been reached.
+   * @param[out] buffer The buffer for the bytes.
+   * @param[in] size The number of bytes the buffer can hold.
+   * @param[in] timeout maximum time to block until.
+   * @returns the number of bytes read.
+   */
+  size_t Receive(void* buffer, size_t size, rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    _ring.WaitForBytes(Min(size, _triggerLevel), timeout);
+    const size_t read = _ring.CopyOut(static_cast<uint8_t*>(buffer), size);
+    _ring.Consume(read);
+    return read;
+  }
+
+  /**
+   * @brief Copies up to \a size bytes out of the stream buffer, to be called by the reader task.
+   * @param[out] buffer The buffer for the bytes.
+   * @param[in] size The number of bytes the buffer can hold.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns the number of bytes read.
+   */
+  template <typename REP, typename PERIOD>
+  size_t Receive(void* buffer, size_t size, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Receive(buffer, size, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Copies up to \a size available bytes out of the stream buffer from within an ISR.
+   * @param[out] buffer The buffer for the bytes.
+   * @param[in] size The number of bytes the buffer can hold.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   * @returns the number of bytes read.
+   */
+  size_t ReceiveFromISR(void* buffer, size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    const size_t read = _ring.CopyOut(static_cast<uint8_t*>(buffer), size);
+    ConsumeFromISR(read, higherPriorityTaskWoken);
+    return read;
+  }
+
+  /**
+   * @brief Reserves free bytes at the write position for in-place writing, to be called by the writer.
+   *        The reserved bytes are contiguous, so the span may be shorter than \a size at the end of the ring,
+   *        reserve again after the commit for the remaining bytes.
+   * @param[in] size The number of bytes to be reserved.
+   * @returns the span of the reserved bytes, it is empty if the stream buffer is full.
+   */
+  Span<uint8_t> Reserve(size_t size)
+  {
+    return _ring.Reserve(size);
+  }
+
+  /**
+   * @brief Publishes the first \a size bytes of the last reservation to the reader.
+   * @param[in] size The number of bytes written, at most the size of the reserved span.
+   */
+  void Commit(size_t size)
+  {
+    _ring.Commit(size);
+  }
+
+  /**
+   * @brief Publishes the first \a size bytes of the last reservation to the reader from within an ISR.
+   * @param[in] size The number of bytes written, at most the size of the reserved span.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   */
+  void CommitFromISR(size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    BaseType_t woken {pdFALSE};
+    _ring.CommitFromISR(size, &woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  }
+
+  /**
+   * @brief Waits until at least \a size bytes are free, to be called by the writer task.
+   * @param[in] size The number of free bytes, at most GetCapacity().
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the bytes are free, false if the timeout has been reached.
+   */
+  bool WaitForSpace(size_t size, rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    return _ring.WaitForSpaces(size, timeout);
+  }
+
+  /**
+   * @brief Returns the available bytes at the read position for in-place reading, to be called by the reader.
+   *        The bytes are contiguous, so the span may be shorter than the available bytes at the end of the ring,
+   *        peek again after the consume for the remaining bytes.
+   * @param[in] size The maximum number of bytes.
+   * @returns the span of the available bytes, it is empty if the stream buffer is empty.
+   */
+  Span<const uint8_t> Peek(size_t size = N)
+  {
+    return _ring.Peek(size);
+  }
+
+  /**
+   * @brief Releases the first \a size bytes of the stream buffer, so they can be written again.
+   * @param[in] size The number of bytes read, at most the size of the peeked span.
+   */
+  void Consume(size_t size)
+  {
+    _ring.Consume(size);
+  }
+
+  /**
+   * @brief Releases the first \a size bytes of the stream buffer from within an ISR.
+   * @param[in] size The number of bytes read, at most the size of the peeked span.
+   * @param[out] higherPriorityTaskWoken See SendFromISR().
+   */
+  void ConsumeFromISR(size_t size, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    BaseType_t woken {pdFALSE};
+    _ring.ConsumeFromISR(size, &woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  }
+
+  /**
+   * @brief Waits until the trigger level number of bytes is available, to be called by the reader task.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the bytes are available, false if the timeout has been reached.
+   */
+  bool WaitForData(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    return _ring.WaitForBytes(_triggerLevel, timeout);
+  }
+
+  /**
+   * @brief Waits until the trigger level number of bytes is available, to be called by the reader task.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the bytes are available, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool WaitForData(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return WaitForData(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @returns the number of bytes, which can be read.
+   */
+  size_t GetBytesAvailable() const
+  {
+    return _ring.GetBytesAvailable();
+  }
+
+  /**
+   * @returns the number of bytes, which can be written.
+   */
+  size_t GetSpacesAvailable() const
+  {
+    return _ring.GetSpacesAvailable();
+  }
+
+  /**
+   * @returns true if the stream buffer does not contain any byte.
+   */
+  bool IsEmpty() const
+  {
+    return (0 == GetBytesAvailable());
+  }
+
+  /**
+   * @returns true if the stream buffer can not take any further byte.
+   */
+  bool IsFull() const
+  {
+    return (0 == GetSpacesAvailable());
+  }
+
+  /**
+   * @brief Removes all bytes from the stream buffer.
+   * @note Must not be called while a writer or reader accesses the stream buffer.
+   */
+  void Reset()
+  {
+    _ring.Reset();
+  }
+
+  private:
+  static constexpr size_t Min(size_t a, size_t b)
+  {
+    return (a < b) ? a : b;
+  }
+
+  private:
+  detail::ByteRing<N> _ring; /** The bytes. */
+  size_t _triggerLevel;      /** The number of bytes, which wake up a blocked reader. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_E41FA3E2232F4E5A8DA0484E76C00D6A
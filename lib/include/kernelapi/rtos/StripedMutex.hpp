@@ -0,0 +1,135 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_F046FF66A27C43B09B74AB74E18AF2F1
+#define HEADER_F046FF66A27C43B09B74AB74E18AF2F1
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include <kernelapi/rtos/MutexTraits.hpp>
+#include <kernelapi/rtos/StaticMutex.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The StripedMutex class protects a large number of small objects with a fixed number of \a N mutexes (lock striping).
+ *        The mutex of an object is selected by a hash of its key or address, thus objects mapped to different stripes can be accessed
+ *        concurrently, while the memory is bounded by \a N mutexes instead of one mutex per object.
+ *        The mutexes are embedded in the StripedMutex, by default as StaticMutex, so no memory is allocated from the RTOS heap.
+ *
+ * @note Different keys may map to the same stripe. When locking the stripes of two keys at the same time, compare GetIndex() of the keys
+ *       and lock the stripe only once, or lock the stripes with rtos::Lock(), otherwise a non-recursive mutex deadlocks.
+ *
+ * @code
+ *   rtos::StripedMutex<16> stripes;
+ *   rtos::LockGuard<rtos::StaticMutex> guard {stripes.For(&record)};
+ * @endcode
+ *
+ * @tparam N The number of stripes, a power of two is recommended.
+ * @tparam MUTEX The mutex type of the stripes.
+ */
+template <size_t N, typename MUTEX = rtos::StaticMutex>
+class StripedMutex
+{
+  static_assert(0 < N, "At least one stripe is required");
+  static_assert(rtos::isBasicLockable<MUTEX>, "MUTEX has to provide Lock() and Unlock(), see MutexTraits.hpp");
+
+  // Make this class non-copyable
+  public:
+  StripedMutex(const StripedMutex& other) = delete;
+  StripedMutex& operator=(const StripedMutex& other) = delete;
+
+  public:
+  StripedMutex() = default;
+
+  public:
+  /**
+   * @returns the number of stripes.
+   */
+  static constexpr size_t GetStripeCount()
+  {
+    return N;
+  }
+
+  /**
+   * @returns the index of the stripe of \a key.
+   * @param[in] key A pointer, an integral value or any key supported by std::hash.
+   */
+  template <typename KEY>
+  static size_t GetIndex(const KEY& key)
+  {
+    const size_t hash = Mix(Hash(key));
+
+    if constexpr (0 == (N & (N - 1)))
+    {
+      return hash & (N - 1);
+    }
+    else
+    {
+      return hash % N;
+    }
+  }
+
+  /**
+   * @returns the mutex of the stripe of \a key.
+   * @param[in] key A pointer, an integral value or any key supported by std::hash.
+   */
+  template <typename KEY>
+  MUTEX& For(const KEY& key)
+  {
+    return _stripes[GetIndex(key)];
+  }
+
+  /**
+   * @returns the mutex of the stripe with the given index.
+   * @param[in] index The index of the stripe, less than GetStripeCount().
+   */
+  MUTEX& At(size_t index)
+  {
+    return _stripes[index];
+  }
+
+  private:
+  template <typename KEY>
+  static size_t Hash(const KEY& key)
+  {
+    if constexpr (std::is_pointer_v<KEY>)
+    {
+      // The lower bits of an address are mostly zero due to the alignment.
+      return static_cast<size_t>(reinterpret_cast<uintptr_t>(key) >> 3);
+    }
+    else if constexpr (std::is_integral_v<KEY> || std::is_enum_v<KEY>)
+    {
+      return static_cast<size_t>(key);
+    }
+    else
+    {
+      return std::hash<KEY>{}(key);
+    }
+  }
+
+  // Spreads the bits of the hash over the whole value (MurmurHash3 finalizer).
+  static size_t Mix(size_t hash)
+  {
+    uint32_t value = static_cast<uint32_t>(hash);
+    value ^= value >> 16;
+    value *= 0x85EBCA6BU;
+    value ^= value >> 13;
+    value *= 0xC2B2AE35U;
+    value ^= value >> 16;
+    return value;
+  }
+
+  private:
+  MUTEX _stripes[N]; /** The mutexes of the stripes. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_F046FF66A27C43B09B74AB74E18AF2F1
@@ -0,0 +1,255 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_781BB997CCD844718D599126F630CE32
+#define HEADER_781BB997CCD844718D599126F630CE32
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/TripleBuffer.hpp>
+
+namespace rtos
+{
+
+// The type of the run time counters, as passed to uxTaskGetSystemState(). Older kernels do not define configRUN_TIME_COUNTER_TYPE.
+#if defined(configRUN_TIME_COUNTER_TYPE)
+using RunTimeCounter_t = configRUN_TIME_COUNTER_TYPE;
+#else
+using RunTimeCounter_t = uint32_t;
+#endif
+
+/**
+ * @brief The statistics of a single task, sampled by the SystemMonitor.
+ */
+struct TaskStats
+{
+  TaskHandle_t handle {nullptr};             /** The native task handle. */
+  char name[configMAX_TASK_NAME_LEN] {};     /** The copy of the task name, null-terminated. */
+  eTaskState state {eInvalid};               /** The state of the task when sampled. */
+  UBaseType_t priority {0};                  /** The current priority, which may be raised by priority inheritance. */
+  BaseType_t core {tskNO_AFFINITY};          /** The core the task is pinned to, tskNO_AFFINITY if not pinned or unknown. */
+  RunTimeCounter_t runTime {0};              /** The run time counter increment during the last period. */
+  uint16_t cpuPermille {0};                  /** The load of one core during the last period in 1/10 percent. */
+  uint32_t stackHighWaterMark {0};           /** The minimum amount of free stack since the task was started, in units of StackType_t. */
+};
+
+/**
+ * @brief The statistics of all tasks, sampled by the SystemMonitor.
+ * @tparam MAX_TASKS The maximum number of tasks.
+ */
+template <size_t MAX_TASKS>
+struct SystemStats
+{
+  TickType_t tick {0};                /** The tick count when sampled. */
+  RunTimeCounter_t totalRunTime {0};  /** The run time counter increment during the last period. */
+  size_t taskCount {0};               /** The number of valid entries of \a tasks. */
+  bool overflow {false};              /** true if more than MAX_TASKS tasks exist, then \a tasks is empty. */
+  TaskStats tasks[MAX_TASKS] {};      /** The statistics of the tasks. */
+};
+
+/**
+ * @brief The SystemMonitor class samples the CPU load and the stack high water mark of all tasks at a fixed period.
+ *        The kernel state is read into a buffer embedded in the SystemMonitor, no memory is allocated from the RTOS heap.
+ *        The CPU load is computed from the increment of the run time counters since the previous sample,
+ *        outside of the scheduler suspension of uxTaskGetSystemState().
+ *        The latest statistics are published through a TripleBuffer, so a telemetry task reads them without any lock
+ *        and never delays the sampling.
+ *
+ * @note The SystemMonitor class uses uxTaskGetSystemState(), which suspends the scheduler while the tasks are copied.
+ *       Requires configUSE_TRACE_FACILITY to be enabled in the RTOS configuration.
+ *       The CPU load requires configGENERATE_RUN_TIME_STATS, otherwise runTime and cpuPermille are 0.
+ *       The core of a task requires configTASKLIST_INCLUDE_COREID, otherwise core is tskNO_AFFINITY.
+ *
+ * @note Only one task may call Sample(). At most \a READERS tasks may hold a snapshot of Read() at the same time.
+ *
+ * Example:
+ * @code
+ * rtos::SystemMonitor<24> monitor {rtos::ToTicks(1s)};
+ * monitorTask.Start(monitor, &rtos::SystemMonitor<24>::Run);
+ *
+ * const auto stats = monitor.Read();
+ * for (size_t i = 0; i < stats->taskCount; ++i) { Report(stats->tasks[i]); }
+ * @endcode
+ *
+ * @tparam MAX_TASKS The maximum number of tasks, including the idle and system tasks.
+ * @tparam READERS The maximum number of tasks reading the statistics at the same time.
+ */
+template <size_t MAX_TASKS, size_t READERS = 1>
+class SystemMonitor
+{
+  static_assert(0 < MAX_TASKS, "The monitor needs at least one task entry");
+
+  public:
+  using Stats = rtos::SystemStats<MAX_TASKS>;
+  using Snapshot = typename rtos::TripleBuffer<Stats, READERS>::Snapshot;
+
+  // Make this class non-copyable
+  public:
+  SystemMonitor(const SystemMonitor& other) = delete;
+  SystemMonitor& operator=(const SystemMonitor& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] period The time between two samples of Run().
+   */
+  explicit SystemMonitor(rtos::Ticks_t period) :
+    _period{period},
+    _status{},
+    _previous{},
+    _previousCount{0},
+    _previousTotalRunTime{0},
+    _stats{}
+  {}
+
+  public:
+  /**
+   * @brief Samples the tasks with the configured period within the calling task, does not return.
+   */
+  void Run()
+  {
+    TickType_t lastWakeTime = xTaskGetTickCount();
+    for (;;)
+    {
+      vTaskDelayUntil(&lastWakeTime, _period.load(std::memory_order_relaxed));
+      Sample();
+    }
+  }
+
+  /**
+   * @brief Samples all tasks once and publishes the statistics, to be called by a single task.
+   * The CPU load is computed for the time since the previous call.
+   */
+  void Sample()
+  {
+    RunTimeCounter_t totalRunTime {0};
+    const size_t count = uxTaskGetSystemState(_status, MAX_TASKS, &totalRunTime);
+
+    Stats& stats = _stats.BeginWrite();
+    stats.tick = xTaskGetTickCount();
+    stats.totalRunTime = totalRunTime - _previousTotalRunTime;
+
+    // The kernel does not copy any task, if the buffer is too small.
+    stats.overflow = (0 == count);
+    stats.taskCount = count;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      const TaskStatus_t& status = _status[i];
+      TaskStats& task = stats.tasks[i];
+
+      task.handle = status.xHandle;
+      std::strncpy(task.name, status.pcTaskName, sizeof(task.name) - 1U);
+      task.name[sizeof(task.name) - 1U] = '\0';
+      task.state = status.eCurrentState;
+      task.priority = status.uxCurrentPriority;
+#if defined(configTASKLIST_INCLUDE_COREID) && configTASKLIST_INCLUDE_COREID
+      task.core = status.xCoreID;
+#else
+      task.core = tskNO_AFFINITY;
+#endif
+      task.runTime = status.ulRunTimeCounter - GetPreviousRunTime(status);
+      task.cpuPermille = (0 < stats.totalRunTime) ?
+        static_cast<uint16_t>((static_cast<uint64_t>(task.runTime) * 1000U) / stats.totalRunTime) : 0;
+      task.stackHighWaterMark = status.usStackHighWaterMark;
+    }
+
+    _stats.Publish();
+
+    // Keep the previous counters on an overflow, so the next sample covers both periods.
+    if (0 < count)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        _previous[i] = {_status[i].xTaskNumber, _status[i].ulRunTimeCounter};
+      }
+      _previousCount = count;
+      _previousTotalRunTime = totalRunTime;
+    }
+  }
+
+  /**
+   * @brief Pins the latest statistics for reading in place, see TripleBuffer::Read().
+   * @returns the Snapshot of the latest statistics, empty until the first Sample().
+   */
+  Snapshot Read() const
+  {
+    return _stats.Read();
+  }
+
+  /**
+   * @brief Copies the latest statistics.
+   * @param[out] stats The copy of the latest statistics.
+   * @returns the sequence number of the statistics, it increments with each Sample().
+   */
+  uint32_t ReadCopy(Stats& stats) const
+  {
+    return _stats.ReadCopy(stats);
+  }
+
+  /**
+   * @returns the sequence number of the latest statistics, it increments with each Sample().
+   */
+  uint32_t GetSequence() const
+  {
+    return _stats.GetSequence();
+  }
+
+  /**
+   * @brief Sets the time between two samples of Run(), takes effect after the next sample.
+   * @param[in] period The period.
+   */
+  void SetPeriod(rtos::Ticks_t period)
+  {
+    _period.store(period, std::memory_order_relaxed);
+  }
+
+  /**
+   * @returns the time between two samples of Run().
+   */
+  rtos::Ticks_t GetPeriod() const
+  {
+    return _period.load(std::memory_order_relaxed);
+  }
+
+  private:
+  struct RunTime
+  {
+    UBaseType_t taskNumber;   /** The unique number of the task, a handle may be reused by a new task. */
+    RunTimeCounter_t runTime; /** The run time counter of the previous sample. */
+  };
+
+  // Returns the run time counter of the previous sample, 0 for a new task.
+  RunTimeCounter_t GetPreviousRunTime(const TaskStatus_t& status) const
+  {
+    for (size_t i = 0; i < _previousCount; ++i)
+    {
+      if (status.xTaskNumber == _previous[i].taskNumber)
+      {
+        return _previous[i].runTime;
+      }
+    }
+    return 0;
+  }
+
+  private:
+  std::atomic<rtos::Ticks_t> _period;             /** The time between two samples of Run(). */
+  TaskStatus_t _status[MAX_TASKS];                /** The buffer for uxTaskGetSystemState(). */
+  RunTime _previous[MAX_TASKS];                   /** The run time counters of the previous sample. */
+  size_t _previousCount;                          /** The number of valid entries of \a _previous. */
+  RunTimeCounter_t _previousTotalRunTime;         /** The total run time counter of the previous sample. */
+  rtos::TripleBuffer<Stats, READERS> _stats;      /** The latest statistics. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_781BB997CCD844718D599126F630CE32
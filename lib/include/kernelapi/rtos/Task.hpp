@@ -0,0 +1,299 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_B22AC2275ACB47039858345FC378D304
+#define HEADER_B22AC2275ACB47039858345FC378D304
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The core affinity of a task.
+ */
+enum class Core : BaseType_t
+{
+  Core0 = 0,                /** The task runs on core 0 only. */
+  Core1 = 1,                /** The task runs on core 1 only. */
+  Any   = tskNO_AFFINITY    /** The scheduler selects the core. */
+};
+
+/**
+ * @brief The Task class runs a function, lambda or member function in its own RTOS task.
+ *        The stack of \a STACK_BYTES and the task control block are embedded in the Task, no memory is allocated from the RTOS heap.
+ *        The entry point is copied into a small buffer within the Task as well, so binding a lambda or member function does not
+ *        allocate a closure.
+ *        The task can be pinned to a core, to get a deterministic placement.
+ *
+ * @note The Task class is a wrapper class for xTaskCreateStaticPinnedToCore() of the ESP-IDF FreeRTOS port.
+ *       See https://docs.espressif.com/projects/esp-idf/en/stable/esp32/api-reference/system/freertos_idf.html
+ *       Requires configSUPPORT_STATIC_ALLOCATION to be enabled in the RTOS configuration.
+ *
+ * @note When the entry point returns, the RTOS task suspends itself. It is deleted by the next Start() or by the destructor,
+ *       which wait until the task does not run on any core anymore. Then the kernel deletes the task immediately and no longer
+ *       accesses the embedded stack and task control block, so the Task can be started again or be destroyed safely.
+ * @note The destructor deletes a still running task, it must not be called by the task itself.
+ *
+ * @tparam STACK_BYTES The size of the stack in bytes.
+ * @tparam ENTRY_BYTES The size of the buffer for the entry point, large enough for a lambda capturing a few pointers.
+ */
+template <size_t STACK_BYTES, size_t ENTRY_BYTES = 4 * sizeof(void*)>
+class Task
+{
+  static_assert(0 == (STACK_BYTES % sizeof(StackType_t)), "The stack size has to be a multiple of StackType_t");
+  static_assert(STACK_BYTES >= (configMINIMAL_STACK_SIZE * sizeof(StackType_t)), "The stack is smaller than configMINIMAL_STACK_SIZE");
+
+  // Make this class non-copyable
+  public:
+  Task(const Task& other) = delete;
+  Task& operator=(const Task& other) = delete;
+
+  public:
+  /**
+   * The constructor stores the task parameters, the task is created by Start().
+   * @param[in] name The name of the task, the string must outlive the Task.
+   * @param[in] priority The priority of the task.
+   * @param[in] core The core the task is pinned to.
+   */
+  explicit Task(const char* name, UBaseType_t priority = 1, Core core = Core::Any) :
+    _name{name},
+    _priority{priority},
+    _core{core},
+    _handle{nullptr},
+    _running{false},
+    _invoke{nullptr},
+    _entry{},
+    _tcb{},
+    _stack{}
+  {}
+
+  /**
+   * @brief Deletes the task, if it is still running.
+   */
+  ~Task()
+  {
+    Delete();
+  }
+
+  public:
+  /**
+   * @brief Creates the task, which calls \a entry.
+   * @param[in] entry The entry point, a function, a function object or a lambda. It is copied into the Task.
+   * @returns true if the task was created, false if the task is already running.
+   */
+  template <typename ENTRY>
+  bool Start(ENTRY&& entry)
+  {
+    using Entry = std::decay_t<ENTRY>;
+    static_assert(sizeof(Entry) <= ENTRY_BYTES, "The entry point is too large, increase ENTRY_BYTES");
+    static_assert(alignof(Entry) <= alignof(std::max_align_t), "The entry point is over-aligned");
+    static_assert(std::is_trivially_destructible_v<Entry>, "The entry point has to be trivially destructible");
+
+    if (_running.load())
+    {
+      return false;
+    }
+
+    // Deletes the suspended task of the previous run, before its storage is reused.
+    Delete();
+
+    new (_entry) Entry(std::forward<ENTRY>(entry));
+    _invoke = [](void* entryPoint) { (*static_cast<Entry*>(entryPoint))(); };
+    _running.store(true);
+
+    const TaskHandle_t handle = xTaskCreateStaticPinnedToCore(&Task::Run, _name, STACK_BYTES / sizeof(StackType_t), this,
+                                                              _priority, _stack, &_tcb, static_cast<BaseType_t>(_core));
+    assert(handle && "Failed to create the task");
+    _running.store(nullptr != handle);
+    _handle.store(handle);
+    return (nullptr != handle);
+  }
+
+  /**
+   * @brief Creates the task, which calls the member function \a method of \a object.
+   * @param[in] object The object, it must outlive the task.
+   * @param[in] method The member function to be called.
+   * @returns true if the task was created, false if the task is already running.
+   */
+  template <typename CLASS>
+  bool Start(CLASS& object, void (CLASS::*method)())
+  {
+    return Start([&object, method]() { (object.*method)(); });
+  }
+
+  /**
+   * @returns true if the task is running, false if it has not been started or its entry point has returned.
+   */
+  bool IsRunning() const
+  {
+    return _running.load();
+  }
+
+  /**
+   * @returns the native task handle, nullptr if the task has not been started or has been deleted.
+   */
+  TaskHandle_t GetHandle() const
+  {
+    return _handle.load();
+  }
+
+  /**
+   * @brief Sets the priority, takes effect immediately if the task is running.
+   * @param[in] priority The new priority.
+   */
+  void SetPriority(UBaseType_t priority)
+  {
+    _priority = priority;
+    const TaskHandle_t handle = _handle.load();
+    if (nullptr != handle)
+    {
+      vTaskPrioritySet(handle, priority);
+    }
+  }
+
+  /**
+   * @returns the priority of the task.
+   */
+  UBaseType_t GetPriority() const
+  {
+    const TaskHandle_t handle = _handle.load();
+    return (nullptr != handle) ? uxTaskPriorityGet(handle) : _priority;
+  }
+
+  /**
+   * @brief Sets the core the task is pinned to.
+   * @param[in] core The core.
+   * @returns true if set, false if the task is running: The ESP-IDF FreeRTOS port does not support changing the affinity of a task.
+   */
+  bool SetCore(Core core)
+  {
+    if (_running.load())
+    {
+      return false;
+    }
+
+    _core = core;
+    return true;
+  }
+
+  /**
+   * @returns the core the task is pinned to.
+   */
+  Core GetCore() const
+  {
+    return _core;
+  }
+
+  /**
+   * @brief Suspends the task.
+   */
+  void Suspend()
+  {
+    const TaskHandle_t handle = _handle.load();
+    if (nullptr != handle)
+    {
+      vTaskSuspend(handle);
+    }
+  }
+
+  /**
+   * @brief Resumes the suspended task.
+   */
+  void Resume()
+  {
+    const TaskHandle_t handle = _handle.load();
+    if (nullptr != handle)
+    {
+      vTaskResume(handle);
+    }
+  }
+
+  /**
+   * @returns the minimum amount of free stack since the task was started, in units of StackType_t, 0 if the task is not running.
+   */
+  uint32_t GetStackHighWaterMark() const
+  {
+    const TaskHandle_t handle = _handle.load();
+    return (nullptr != handle) ? uxTaskGetStackHighWaterMark(handle) : 0;
+  }
+
+  /**
+   * @returns the size of the stack in bytes.
+   */
+  static constexpr size_t GetStackSize()
+  {
+    return STACK_BYTES;
+  }
+
+  private:
+  static void Run(void* param)
+  {
+    Task& task = *static_cast<Task*>(param);
+
+    // The task may run before Start() has stored the handle, e.g. on the other core. Wait for it, so GetHandle() is valid within the entry point.
+    while (nullptr == task._handle.load())
+    {
+      vTaskDelay(1);
+    }
+
+    task._invoke(task._entry);
+
+    // A task must not return. It suspends itself instead, so Delete() can delete it once it is switched out.
+    task._running.store(false);
+    for (;;)
+    {
+      vTaskSuspend(nullptr);
+    }
+  }
+
+  // Deletes the native task. A task deleted while it runs on a core is only deleted later by the idle task,
+  // so the task is suspended first and deleted once it is switched out.
+  void Delete()
+  {
+    const TaskHandle_t handle = _handle.load();
+    if (nullptr == handle)
+    {
+      return;
+    }
+
+    assert((xTaskGetCurrentTaskHandle() != handle) && "The task cannot delete itself");
+
+    vTaskSuspend(handle);
+    while (eSuspended != eTaskGetState(handle))
+    {
+      vTaskDelay(1);
+    }
+
+    vTaskDelete(handle);
+    _handle.store(nullptr);
+  }
+
+  private:
+  const char* const _name;                                /** The name of the task. */
+  UBaseType_t _priority;                                  /** The priority, used when the task is created. */
+  Core _core;                                             /** The core the task is pinned to. */
+  std::atomic<TaskHandle_t> _handle;                      /** The native task handle, nullptr if the task is not created. */
+  std::atomic<bool> _running;                             /** true while the entry point is running. */
+  void (*_invoke)(void*);                                 /** Calls the entry point. */
+  alignas(std::max_align_t) uint8_t _entry[ENTRY_BYTES];  /** The copy of the entry point. */
+  StaticTask_t _tcb;                                      /** The memory of the task control block. */
+  StackType_t _stack[STACK_BYTES / sizeof(StackType_t)];  /** The memory of the stack. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_B22AC2275ACB47039858345FC378D304
@@ -0,0 +1,191 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_35566632A88843EE9EDDE351FA6594E2
+#define HEADER_35566632A88843EE9EDDE351FA6594E2
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The TaskSemaphore class is a lightweight counting semaphore, which is taken by a single owner task only.
+ *        It is built on the direct to task notification of the owner task, thus it needs no kernel object and no extra RAM,
+ *        and giving and taking is considerably faster than with a queue based semaphore.
+ *        Any task or ISR can give the semaphore.
+ *
+ * @note See https://www.freertos.org/RTOS-task-notifications.html for details on task notifications.
+ *       The TaskSemaphore uses the task notification (index 0) of the owner task, do not use it for another purpose.
+ *
+ * @note Only the owner task may call Take()! Use GiveFromISR() within an ISR.
+ */
+class TaskSemaphore
+{
+  // Make this class non-copyable
+  public:
+  TaskSemaphore(const TaskSemaphore& other) = delete;
+  TaskSemaphore& operator=(const TaskSemaphore& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] owner The task, which takes the semaphore. If nullptr, SetOwner() has to be called before the first Take(),
+   *            the counts given before are kept and taken by the owner.
+   */
+  explicit TaskSemaphore(TaskHandle_t owner = nullptr) :
+    _owner{owner},
+    _pending{0}
+  {}
+
+  public:
+  /**
+   * @brief Sets the task, which takes the semaphore.
+   * @param[in] owner The owner task.
+   * @note Must not be called while the current owner is waiting in Take().
+   */
+  void SetOwner(TaskHandle_t owner)
+  {
+    _owner.store(owner);
+  }
+
+  /**
+   * @returns the task which takes the semaphore, nullptr if there is no owner yet.
+   */
+  TaskHandle_t GetOwner() const
+  {
+    return _owner.load();
+  }
+
+  /**
+   * @brief Gives the semaphore, i.e. increments the count and unblocks the owner task if it is waiting.
+   * @note If there is no owner yet, the count is kept until the owner takes it.
+   */
+  void Give()
+  {
+    const TaskHandle_t owner = GetOwnerOrKeep();
+    if (nullptr != owner)
+    {
+      xTaskNotifyGive(owner);
+    }
+  }
+
+  /**
+   * @brief Gives the semaphore from within an ISR.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if giving unblocked a task of higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @note If there is no owner yet, the count is kept until the owner takes it.
+   */
+  void GiveFromISR(BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    const TaskHandle_t owner = GetOwnerOrKeep();
+    if (nullptr != owner)
+    {
+      BaseType_t woken {pdFALSE};
+      vTaskNotifyGiveFromISR(owner, &woken);
+
+      detail::YieldFromISR(woken, higherPriorityTaskWoken);
+    }
+  }
+
+  /**
+   * @brief Takes the semaphore, i.e. decrements the count.
+   * If the count is zero, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the semaphore was taken, false if the timeout has been reached.
+   */
+  bool Take(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    AssertOwner();
+
+    // The counts given before the owner was set are taken first.
+    return TakePending() || (0 != ulTaskNotifyTake(pdFALSE, timeout));
+  }
+
+  /**
+   * @brief Takes the semaphore, i.e. decrements the count.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the semaphore was taken, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool Take(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Take(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Takes all counts of the semaphore at once, i.e. clears the count.
+   * If the count is zero, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns the count before it was cleared, 0 if the timeout has been reached.
+   */
+  uint32_t TakeAll(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    AssertOwner();
+
+    const uint32_t pending = _pending.exchange(0);
+    return pending + ulTaskNotifyTake(pdTRUE, (0 != pending) ? 0 : timeout);
+  }
+
+  private:
+  void AssertOwner() const
+  {
+    assert((nullptr != _owner.load()) && "The owner has to be set before the semaphore is taken");
+    assert((xTaskGetCurrentTaskHandle() == _owner.load()) && "Only the owner task can take the semaphore");
+  }
+
+  // Returns the owner, or keeps the count in _pending and returns nullptr if there is no owner yet.
+  TaskHandle_t GetOwnerOrKeep()
+  {
+    TaskHandle_t owner = _owner.load();
+    if (nullptr != owner)
+    {
+      return owner;
+    }
+
+    _pending.fetch_add(1U);
+
+    // The owner may have been set in the meantime and may already wait for the notification, then move the count over.
+    // Either the owner or this call takes the count out of _pending, it is never lost or doubled.
+    owner = _owner.load();
+    if (nullptr == owner)
+    {
+      return nullptr;
+    }
+
+    return TakePending() ? owner : nullptr;
+  }
+
+  // Takes one of the counts given before the owner was set.
+  bool TakePending()
+  {
+    uint32_t pending = _pending.load();
+    while (0 != pending)
+    {
+      if (_pending.compare_exchange_weak(pending, pending - 1U))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  private:
+  std::atomic<TaskHandle_t> _owner;   /** The task, which takes the semaphore. */
+  std::atomic<uint32_t> _pending;     /** The counts given before the owner was set. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_35566632A88843EE9EDDE351FA6594E2
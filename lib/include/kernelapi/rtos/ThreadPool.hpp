@@ -0,0 +1,403 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_A6A015AE95314DD0B2B06F52A09973BE
+#define HEADER_A6A015AE95314DD0B2B06F52A09973BE
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Job.hpp>
+#include <kernelapi/rtos/Queue.hpp>
+#include <kernelapi/rtos/Task.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/WorkStealingDeque.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The ThreadPool class runs short, independent jobs on one worker task per core.
+ *        Each worker owns a lock-free deque: Jobs submitted by a running job are pushed to the deque of its worker,
+ *        jobs submitted by other tasks or ISRs are passed through a shared queue. A worker running out of work steals
+ *        the oldest jobs of the other workers, so no core idles while the other one has jobs queued up.
+ *        Idle workers block on their task notification and are woken when a job is submitted.
+ *        The workers, their stacks and the jobs are embedded in the ThreadPool, no memory is allocated from the RTOS heap.
+ *
+ * @note Only one task at a time may call WaitAll(), it uses the task notification (index 0) of the waiting task.
+ *       Do not call WaitAll() from a job.
+ * @note The workers sleep on their task notification (index 0), jobs must not use it for another purpose.
+ *
+ * Example:
+ * @code
+ * rtos::ThreadPool<> pool {"pool"};
+ * pool.Start();
+ * pool.Submit([&packet]() { Decode(packet); });
+ * pool.WaitAll();
+ * @endcode
+ *
+ * @tparam QUEUE_SIZE The number of jobs, which can be submitted by other tasks before they are taken by a worker.
+ * @tparam DEQUE_SIZE The number of jobs within the deque of a worker, must be a power of two.
+ * @tparam STACK_BYTES The size of the stack of a worker in bytes.
+ * @tparam JOB_BYTES The size of the buffer of a job, see Job.
+ */
+template <size_t QUEUE_SIZE = 16, size_t DEQUE_SIZE = 32, size_t STACK_BYTES = 4096, size_t JOB_BYTES = 4 * sizeof(void*)>
+class ThreadPool
+{
+  static_assert(portNUM_PROCESSORS <= 32, "The idle workers are tracked in a 32 bit mask");
+
+  public:
+  using JobType = rtos::Job<JOB_BYTES>;
+
+  // Make this class non-copyable
+  public:
+  ThreadPool(const ThreadPool& other) = delete;
+  ThreadPool& operator=(const ThreadPool& other) = delete;
+
+  public:
+  /**
+   * The constructor stores the worker parameters, the workers are created by Start().
+   * @param[in] name The name of the worker tasks, the string must outlive the ThreadPool.
+   * @param[in] priority The priority of the worker tasks.
+   */
+  explicit ThreadPool(const char* name, UBaseType_t priority = 1) :
+    ThreadPool(name, priority, std::make_index_sequence<workerCount>{})
+  {}
+
+  /**
+   * @brief Deletes the workers, before the shared queue is destroyed. Jobs, which have not been run yet, are dropped.
+   * @note Call WaitAll() before, no job must be running while the ThreadPool is destroyed.
+   */
+  ~ThreadPool()
+  {
+    // An idle worker may still steal from the deque of another one, so all workers are suspended before the first is deleted.
+    for (Worker& worker : _workers)
+    {
+      const TaskHandle_t handle = worker.task.GetHandle();
+      if (nullptr != handle)
+      {
+        vTaskSuspend(handle);
+      }
+    }
+  }
+
+  public:
+  /**
+   * @brief Creates the worker tasks, each one pinned to its core.
+   * @returns true if all workers are running.
+   */
+  bool Start()
+  {
+    bool started {true};
+    for (Worker& worker : _workers)
+    {
+      started = (worker.task.IsRunning() || worker.task.Start(worker, &Worker::Run)) && started;
+    }
+    return started;
+  }
+
+  /**
+   * @returns the number of workers, one per core.
+   */
+  static constexpr size_t GetWorkerCount()
+  {
+    return workerCount;
+  }
+
+  /**
+   * @brief Submits the job to be run by one of the workers.
+   * Called by a running job, the job is pushed to the deque of its worker, otherwise to the shared queue.
+   * If the queue is full, it blocks until specified timeout has been reached.
+   * @param[in] job The job, e.g. a lambda.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if the job was submitted, false if the timeout has been reached.
+   */
+  bool Submit(const JobType& job, rtos::Ticks_t timeout = 0)
+  {
+    _pending.fetch_add(1U);
+
+    Worker* const self = FindWorker(xTaskGetCurrentTaskHandle());
+    if (((nullptr == self) || !self->deque.Push(job)) && !_queue.Send(job, timeout))
+    {
+      Finish();
+      return false;
+    }
+
+    WakeIdleWorker();
+    return true;
+  }
+
+  /**
+   * @brief Submits the job to be run by one of the workers.
+   * @param[in] job The job, e.g. a lambda.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if the job was submitted, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool Submit(const JobType& job, const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return Submit(job, rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @brief Submits the job from within an ISR, it is passed to the shared queue.
+   * @param[in] job The job, e.g. a lambda.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if a worker of higher priority than the interrupted task was unblocked.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns true if the job was submitted, false if the queue is full.
+   */
+  bool SubmitFromISR(const JobType& job, BaseType_t* higherPriorityTaskWoken = nullptr)
+  {
+    _pending.fetch_add(1U);
+
+    BaseType_t woken {pdFALSE};
+    if (!_queue.SendFromISR(job, &woken))
+    {
+      FinishFromISR(&woken);
+      detail::YieldFromISR(woken, higherPriorityTaskWoken);
+      return false;
+    }
+
+    WakeIdleWorkerFromISR(&woken);
+    detail::YieldFromISR(woken, higherPriorityTaskWoken);
+    return true;
+  }
+
+  /**
+   * @brief Waits until all submitted jobs have been run, including the jobs submitted by jobs meanwhile.
+   * If jobs are pending, it blocks until specified timeout has been reached.
+   * @param[in] timeout maximum time to block until.
+   * @returns true if all jobs have been run, false if the timeout has been reached.
+   */
+  bool WaitAll(rtos::Ticks_t timeout = GetMaxDelay())
+  {
+    TimeOut_t timeOutState;
+    TickType_t remaining {timeout};
+    vTaskSetTimeOutState(&timeOutState);
+
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (;;)
+    {
+      _waiter.store(self);
+
+      // Pairs with the fence in Finish(), so either the last job sees the waiter and notifies or we see no pending job.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      if ((0 == _pending.load()) || (0 == ulTaskNotifyTake(pdTRUE, remaining)))
+      {
+        break;
+      }
+
+      // The last job has claimed the waiter. Check again, jobs may have been submitted meanwhile.
+      if (pdTRUE == xTaskCheckForTimeOut(&timeOutState, &remaining))
+      {
+        return (0 == _pending.load());
+      }
+    }
+
+    // The last job claimed the waiter concurrently, consume its notification, so it is not left over for the next WaitAll().
+    if (nullptr == _waiter.exchange(nullptr))
+    {
+      // Use while loop in case infinite wait is not implemented by the rtos port.
+      while (0 == ulTaskNotifyTake(pdTRUE, GetMaxDelay()))
+      {
+      }
+    }
+
+    return (0 == _pending.load());
+  }
+
+  /**
+   * @brief Waits until all submitted jobs have been run.
+   * @param[in] timeout maximum duration to block until, rounded up to the next tick.
+   * @returns true if all jobs have been run, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool WaitAll(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return WaitAll(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * @returns the number of jobs, which have been submitted and not finished yet.
+   */
+  uint32_t GetPending() const
+  {
+    return _pending.load();
+  }
+
+  private:
+  static constexpr size_t workerCount {portNUM_PROCESSORS};
+
+  struct Worker
+  {
+    Worker(ThreadPool& owner, size_t workerIndex, const char* name, UBaseType_t priority) :
+      pool{owner},
+      index{workerIndex},
+      task{name, priority, static_cast<rtos::Core>(workerIndex)},
+      deque{}
+    {}
+
+    void Run()
+    {
+      pool.RunWorker(*this);
+    }
+
+    ThreadPool& pool;                                         /** The pool of the worker. */
+    const size_t index;                                       /** The index of the worker, which is the core it is pinned to. */
+    rtos::Task<STACK_BYTES> task;                             /** The worker task. */
+    detail::WorkStealingDeque<JobType, DEQUE_SIZE> deque;     /** The jobs submitted by the jobs of this worker. */
+  };
+
+  template <size_t... INDEX>
+  ThreadPool(const char* name, UBaseType_t priority, std::index_sequence<INDEX...>) :
+    _queue{},
+    _pending{0},
+    _idle{0},
+    _waiter{nullptr},
+    _workers{{*this, INDEX, name, priority}...}
+  {}
+
+  void RunWorker(Worker& self)
+  {
+    const uint32_t bit {1U << self.index};
+    JobType job;
+
+    for (;;)
+    {
+      if (!FindJob(self, job))
+      {
+        _idle.fetch_or(bit);
+
+        // Pairs with the fence in WakeIdleWorker(), so either the submitter sees this worker idle or we see the new job.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (!FindJob(self, job))
+        {
+          ulTaskNotifyTake(pdTRUE, GetMaxDelay());
+          _idle.fetch_and(~bit);
+          continue;
+        }
+        _idle.fetch_and(~bit);
+      }
+
+      job();
+      Finish();
+    }
+  }
+
+  // Takes a job of the own deque, of the shared queue or steals one of the other workers.
+  bool FindJob(Worker& self, JobType& job)
+  {
+    if (self.deque.Pop(job) || _queue.Receive(job, 0))
+    {
+      return true;
+    }
+
+    for (size_t i = 1; i < workerCount; ++i)
+    {
+      if (_workers[(self.index + i) % workerCount].deque.Steal(job))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  Worker* FindWorker(TaskHandle_t task)
+  {
+    for (Worker& worker : _workers)
+    {
+      if (task == worker.task.GetHandle())
+      {
+        return &worker;
+      }
+    }
+    return nullptr;
+  }
+
+  // Returns the task of an idle worker, which is no longer marked idle, nullptr if all workers are busy.
+  TaskHandle_t ClaimIdleWorker()
+  {
+    // Pairs with the fence in RunWorker().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint32_t idle = _idle.load();
+    while (0 != idle)
+    {
+      const uint32_t bit = idle & (~idle + 1U);
+      if (0 != (_idle.fetch_and(~bit) & bit))
+      {
+        return _workers[__builtin_ctz(bit)].task.GetHandle();
+      }
+      idle = _idle.load();
+    }
+    return nullptr;
+  }
+
+  void WakeIdleWorker()
+  {
+    const TaskHandle_t worker = ClaimIdleWorker();
+    if (nullptr != worker)
+    {
+      xTaskNotifyGive(worker);
+    }
+  }
+
+  void WakeIdleWorkerFromISR(BaseType_t* woken)
+  {
+    const TaskHandle_t worker = ClaimIdleWorker();
+    if (nullptr != worker)
+    {
+      vTaskNotifyGiveFromISR(worker, woken);
+    }
+  }
+
+  // Marks a job as finished, the last one wakes the task waiting in WaitAll().
+  void Finish()
+  {
+    if (1U == _pending.fetch_sub(1U))
+    {
+      // Pairs with the fence in WaitAll(). The waiter is claimed, so it is notified only once.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const TaskHandle_t waiter = _waiter.exchange(nullptr);
+      if (nullptr != waiter)
+      {
+        xTaskNotifyGive(waiter);
+      }
+    }
+  }
+
+  void FinishFromISR(BaseType_t* woken)
+  {
+    if (1U == _pending.fetch_sub(1U))
+    {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const TaskHandle_t waiter = _waiter.exchange(nullptr);
+      if (nullptr != waiter)
+      {
+        vTaskNotifyGiveFromISR(waiter, woken);
+      }
+    }
+  }
+
+  private:
+  rtos::Queue<JobType, QUEUE_SIZE> _queue;  /** The jobs submitted by other tasks and ISRs. */
+  std::atomic<uint32_t> _pending;           /** The number of submitted and not finished jobs. */
+  std::atomic<uint32_t> _idle;              /** The mask of the idle workers, indexed by the core. */
+  std::atomic<TaskHandle_t> _waiter;        /** The task waiting in WaitAll(), nullptr if none. */
+  Worker _workers[workerCount];             /** The workers, one per core. Declared last, so they are deleted first. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_A6A015AE95314DD0B2B06F52A09973BE
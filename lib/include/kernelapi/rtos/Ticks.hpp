@@ -7,14 +7,78 @@
 #ifndef HEADER_E6B858AC2F954CCCB28F5F03478CFC9E
 #define HEADER_E6B858AC2F954CCCB28F5F03478CFC9E
 
+#include <chrono>
 #include <cstdint>
 
+// The host backend (KERNELAPI_BACKEND_HOST defined in the build flags) emulates the RTOS ticks without FreeRTOS.
+// Its tick rate can be overridden by defining KERNELAPI_HOST_TICK_RATE_HZ, by default 1 kHz.
+#if defined(KERNELAPI_BACKEND_HOST)
+  #if !defined(KERNELAPI_HOST_TICK_RATE_HZ)
+    #define KERNELAPI_HOST_TICK_RATE_HZ 1000
+  #endif
+  #define KERNELAPI_TICK_RATE_HZ KERNELAPI_HOST_TICK_RATE_HZ
+  #define KERNELAPI_MAX_DELAY 0xFFFFFFFFUL
+#else
+  #include <freertos/FreeRTOS.h>
+  #define KERNELAPI_TICK_RATE_HZ configTICK_RATE_HZ
+  #define KERNELAPI_MAX_DELAY portMAX_DELAY
+#endif
+
 namespace rtos
 {
 
 using Ticks_t = uint32_t;
 
-Ticks_t GetMaxDelay();
+/**
+ * @brief The std::chrono duration of a single RTOS tick.
+ */
+using TickDuration = std::chrono::duration<int64_t, std::ratio<1, KERNELAPI_TICK_RATE_HZ>>;
+
+/**
+ * @returns the timeout value which blocks indefinitely.
+ */
+constexpr Ticks_t GetMaxDelay()
+{
+  return static_cast<Ticks_t>(KERNELAPI_MAX_DELAY);
+}
+
+/**
+ * @brief Converts a std::chrono duration into RTOS ticks.
+ *        The duration is rounded up to the next tick, thus a non-zero duration never results in a zero timeout.
+ *        Negative durations and NaN result in 0, durations that do not fit into Ticks_t are limited to GetMaxDelay() - 1,
+ *        so that a finite duration never becomes an infinite timeout, e.g. ToTicks(std::chrono::seconds::max()).
+ * @param[in] duration The duration to be converted.
+ * @returns the duration in RTOS ticks.
+ * @note The conversion is constexpr, e.g. ToTicks(5ms) is evaluated at compile time.
+ */
+template <typename REP, typename PERIOD>
+constexpr Ticks_t ToTicks(const std::chrono::duration<REP, PERIOD>& duration)
+{
+  constexpr Ticks_t maxTicks = GetMaxDelay() - 1;
+
+  // The limits are checked in floating point, the integer conversion of a huge duration overflows before it could be limited.
+  const double ticks = std::chrono::duration<double, TickDuration::period>(duration).count();
+
+  // Also true for NaN.
+  if (!(0.0 < ticks))
+  {
+    return 0;
+  }
+
+  if (static_cast<double>(maxTicks) <= ticks)
+  {
+    return maxTicks;
+  }
+
+  const int64_t rounded = std::chrono::ceil<TickDuration>(duration).count();
+  return static_cast<Ticks_t>((rounded < maxTicks) ? rounded : maxTicks);
+}
+
+static_assert(0 == ToTicks(std::chrono::seconds::min()), "A negative duration must result in 0");
+static_assert(1 == ToTicks(std::chrono::nanoseconds{1}), "A non-zero duration must result in at least one tick");
+static_assert((GetMaxDelay() - 1) == ToTicks(std::chrono::seconds::max()), "A huge duration must be limited");
+static_assert((GetMaxDelay() - 1) == ToTicks(std::chrono::duration<double>{1e30}), "A huge duration must be limited");
+static_assert(0 == ToTicks(std::chrono::duration<double>{-1e30}), "A negative duration must result in 0");
 
 } // namespace rtos
 
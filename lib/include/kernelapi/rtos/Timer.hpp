@@ -0,0 +1,176 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_6390010F4EDE4A4BB547C763FB6F826D
+#define HEADER_6390010F4EDE4A4BB547C763FB6F826D
+
+#include <type_traits>
+#include <utility>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+
+#include <kernelapi/rtos/Job.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The Timer class calls a function, lambda or member function from the timer service task after a period.
+ *        The memory of the native timer is embedded in the Timer, no memory is allocated from the RTOS heap.
+ *        The callback is copied into a Job within the Timer, so binding a member function does not allocate a closure
+ *        and the callback does not need a void* context.
+ *
+ * @note The Timer class is a wrapper class for the native RTOS software timer implementation.
+ *       See https://www.freertos.org/FreeRTOS-Software-Timer-API-Functions.html for details.
+ *       Requires configUSE_TIMERS, configSUPPORT_STATIC_ALLOCATION and INCLUDE_xTimerPendFunctionCall to be enabled in the RTOS configuration.
+ *
+ * @note The callback runs within the timer service task, it must not block.
+ *       Each command, e.g. Start() or Stop(), is sent through the command queue of the timer service task,
+ *       the timeout specifies how long to wait if that queue is full. Use a TimerWheel for many short-lived timeouts.
+ * @note Use the FromISR methods when called within an ISR.
+ */
+class Timer
+{
+  public:
+  using Callback = rtos::Job<>;
+
+  // Make this class non-copyable
+  public:
+  Timer(const Timer& other) = delete;
+  Timer& operator=(const Timer& other) = delete;
+
+  public:
+  /**
+   * The constructor creates the native RTOS timer within the embedded storage, the timer is started by Start().
+   * @param[in] name The name of the timer, the string must outlive the Timer.
+   * @param[in] period The period, must be greater than 0.
+   * @param[in] autoReload If true, the timer restarts after each expiry, otherwise it expires once.
+   * @param[in] callback The function, function object or lambda to be called, it is copied into the Timer.
+   */
+  template <typename CALLBACK, typename = std::enable_if_t<!std::is_same_v<std::decay_t<CALLBACK>, Callback>>>
+  Timer(const char* name, rtos::Ticks_t period, bool autoReload, CALLBACK&& callback) :
+    Timer(name, period, autoReload, Callback{std::forward<CALLBACK>(callback)})
+  {}
+
+  /**
+   * The constructor creates the native RTOS timer, which calls the member function \a method of \a object.
+   * @param[in] name The name of the timer, the string must outlive the Timer.
+   * @param[in] period The period, must be greater than 0.
+   * @param[in] autoReload If true, the timer restarts after each expiry, otherwise it expires once.
+   * @param[in] object The object, it must outlive the Timer.
+   * @param[in] method The member function to be called.
+   */
+  template <typename CLASS>
+  Timer(const char* name, rtos::Ticks_t period, bool autoReload, CLASS& object, void (CLASS::*method)()) :
+    Timer(name, period, autoReload, Callback{[&object, method]() { (object.*method)(); }})
+  {}
+
+  /**
+   * @brief Destroy the timer handle, a running timer is stopped.
+   * Blocks until the timer service task has deleted the timer, so the callback is neither running nor called afterwards.
+   * @note Must not be called within the timer service task, e.g. within a callback of a Timer.
+   */
+  ~Timer();
+
+  public:
+  /**
+   * @returns true if the timer was created successfully, false otherwise.
+   */
+  bool IsValid() const;
+
+  /**
+   * @brief Starts the timer, a running timer is restarted.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  bool Start(rtos::Ticks_t timeout = 0);
+
+  /**
+   * @brief Stops the timer.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  bool Stop(rtos::Ticks_t timeout = 0);
+
+  /**
+   * @brief Restarts the timer, so it expires one period after this call.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  bool Reset(rtos::Ticks_t timeout = 0);
+
+  /**
+   * @brief Changes the period and starts the timer.
+   * @param[in] period The new period, must be greater than 0.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  bool ChangePeriod(rtos::Ticks_t period, rtos::Ticks_t timeout = 0);
+
+  /**
+   * @brief Changes the period and starts the timer.
+   * @param[in] period The new period, rounded up to the next tick.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  template <typename REP, typename PERIOD>
+  bool ChangePeriod(const std::chrono::duration<REP, PERIOD>& period, rtos::Ticks_t timeout = 0)
+  {
+    return ChangePeriod(rtos::ToTicks(period), timeout);
+  }
+
+  /**
+   * @brief Starts the timer from within an ISR.
+   * @param[out] higherPriorityTaskWoken Set to pdTRUE if the timer service task has a higher priority than the interrupted task.
+   *             The caller is responsible to yield at the end of the ISR. If nullptr, the method yields itself if required.
+   * @returns true if the command was sent, false if the command queue is full.
+   */
+  bool StartFromISR(BaseType_t* higherPriorityTaskWoken = nullptr);
+
+  /**
+   * @brief Stops the timer from within an ISR.
+   * @param[out] higherPriorityTaskWoken See StartFromISR().
+   * @returns true if the command was sent, false if the command queue is full.
+   */
+  bool StopFromISR(BaseType_t* higherPriorityTaskWoken = nullptr);
+
+  /**
+   * @brief Restarts the timer from within an ISR.
+   * @param[out] higherPriorityTaskWoken See StartFromISR().
+   * @returns true if the command was sent, false if the command queue is full.
+   */
+  bool ResetFromISR(BaseType_t* higherPriorityTaskWoken = nullptr);
+
+  /**
+   * @returns true if the timer is running.
+   */
+  bool IsActive() const;
+
+  /**
+   * @returns the period of the timer.
+   */
+  rtos::Ticks_t GetPeriod() const;
+
+  /**
+   * @returns the tick count when the timer expires, only valid if the timer is running.
+   */
+  TickType_t GetExpiryTime() const;
+
+  private:
+  Timer(const char* name, rtos::Ticks_t period, bool autoReload, const Callback& callback);
+
+  static void OnExpired(TimerHandle_t handle);
+
+  private:
+  Callback _callback;     /** The copy of the callback. */
+  StaticTimer_t _storage; /** The memory of the native timer. */
+  TimerHandle_t _handle;  /** The native timer handle managed by an instance of this class. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_6390010F4EDE4A4BB547C763FB6F826D
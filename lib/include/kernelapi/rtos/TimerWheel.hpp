@@ -0,0 +1,399 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_FD524B4697F641BABF78FFDC33FB5462
+#define HEADER_FD524B4697F641BABF78FFDC33FB5462
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include <kernelapi/rtos/Job.hpp>
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/SpinLock.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/Timer.hpp>
+
+namespace rtos
+{
+
+template <size_t SLOT_BITS, size_t LEVELS>
+class TimerWheel;
+
+/**
+ * @brief The WheelTimer class is an application timeout, which is armed within a TimerWheel.
+ *        The WheelTimer is owned by the application and linked into the wheel, so arming it does not allocate any memory.
+ *        The callback is copied into a Job within the WheelTimer.
+ *
+ * @note The WheelTimer must not be destroyed while it is armed.
+ */
+class WheelTimer
+{
+  public:
+  using Callback = rtos::Job<>;
+
+  // Make this class non-copyable
+  public:
+  WheelTimer(const WheelTimer& other) = delete;
+  WheelTimer& operator=(const WheelTimer& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] callback The function, function object or lambda to be called on expiry, it is copied into the WheelTimer.
+   */
+  template <typename CALLBACK, typename = std::enable_if_t<!std::is_same_v<std::decay_t<CALLBACK>, WheelTimer>>>
+  explicit WheelTimer(CALLBACK&& callback) :
+    _callback{std::forward<CALLBACK>(callback)},
+    _next{nullptr},
+    _prev{nullptr},
+    _expiry{0},
+    _period{0},
+    _level{0},
+    _slot{0},
+    _armed{false}
+  {}
+
+  /**
+   * The constructor binds the member function \a method of \a object as callback.
+   * @param[in] object The object, it must outlive the WheelTimer.
+   * @param[in] method The member function to be called on expiry.
+   */
+  template <typename CLASS>
+  WheelTimer(CLASS& object, void (CLASS::*method)()) :
+    WheelTimer([&object, method]() { (object.*method)(); })
+  {}
+
+  public:
+  /**
+   * @returns true if the timer is armed, the value may be outdated when the wheel is active.
+   */
+  bool IsArmed() const
+  {
+    return _armed.load(std::memory_order_relaxed);
+  }
+
+  private:
+  template <size_t SLOT_BITS, size_t LEVELS>
+  friend class TimerWheel;
+
+  private:
+  Callback _callback;         /** The copy of the callback. */
+  WheelTimer* _next;          /** The next timer within the slot. */
+  WheelTimer* _prev;          /** The previous timer within the slot, nullptr if it is the first one. */
+  uint64_t _expiry;           /** The wheel tick of the expiry. */
+  uint32_t _period;           /** The period in wheel ticks, 0 for a one-shot timer. */
+  uint8_t _level;             /** The level of the slot the timer is linked into. */
+  uint8_t _slot;              /** The slot within the level the timer is linked into. */
+  std::atomic<bool> _armed;   /** true if the timer is linked into the wheel. */
+};
+
+/**
+ * @brief The TimerWheel class multiplexes many application timeouts onto a single kernel Timer.
+ *        Arming, re-arming and cancelling a WheelTimer is O(1) and does not send any command to the timer service task,
+ *        so thousands of timeouts cause no traffic on its command queue.
+ *        The wheel is hierarchical: The first level has one slot per wheel tick, each further level has slots for
+ *        2^SLOT_BITS times longer intervals, whose timers are cascaded into the lower levels as time advances.
+ *
+ * @note The kernel Timer expires every \a resolution ticks while the wheel runs, the callbacks are called within
+ *       the timer service task and must not block. Like vTaskDelay(), the first period may be shortened by up to one resolution.
+ * @note The destructor waits until the kernel timer is deleted, it must not be called within the timer service task,
+ *       e.g. within a callback of a WheelTimer.
+ * @note The wheel is protected by a SpinLock, each locked section handles a single timer.
+ *       Cancel() returns false when the callback is already due, it may still be running.
+ *
+ * Example:
+ * @code
+ * rtos::TimerWheel<> wheel {"wheel"};
+ * rtos::WheelTimer timeout {connection, &Connection::OnTimeout};
+ * wheel.Start();
+ * wheel.Arm(timeout, rtos::ToTicks(500ms));
+ * @endcode
+ *
+ * @tparam SLOT_BITS The number of slots per level is 2^SLOT_BITS.
+ * @tparam LEVELS The number of levels, the range without re-cascading is 2^(SLOT_BITS * LEVELS) wheel ticks.
+ */
+template <size_t SLOT_BITS = 6, size_t LEVELS = 4>
+class TimerWheel
+{
+  static_assert((0 < SLOT_BITS) && (SLOT_BITS <= 8), "SLOT_BITS has to be in the range of 1 to 8");
+  static_assert((0 < LEVELS) && ((SLOT_BITS * LEVELS) < 64), "LEVELS has to be in the range of 1 to 63 / SLOT_BITS");
+
+  // Make this class non-copyable
+  public:
+  TimerWheel(const TimerWheel& other) = delete;
+  TimerWheel& operator=(const TimerWheel& other) = delete;
+
+  public:
+  /**
+   * The constructor creates the kernel timer, the wheel is started by Start().
+   * @param[in] name The name of the kernel timer, the string must outlive the TimerWheel.
+   * @param[in] resolution The duration of a wheel tick.
+   */
+  explicit TimerWheel(const char* name, rtos::Ticks_t resolution = 1) :
+    _resolution{(0 < resolution) ? resolution : 1},
+    _lock{},
+    _slots{},
+    _now{0},
+    _count{0},
+    _timer{name, _resolution, true, *this, &TimerWheel::OnTick}
+  {}
+
+  public:
+  /**
+   * @brief Starts the kernel timer.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  bool Start(rtos::Ticks_t timeout = 0)
+  {
+    return _timer.Start(timeout);
+  }
+
+  /**
+   * @brief Stops the kernel timer, the armed timers are kept but their expiry is delayed until the wheel is started again.
+   * @param[in] timeout maximum time to block until the command queue of the timer service task accepts the command.
+   * @returns true if the command was sent, false if the timeout has been reached.
+   */
+  bool Stop(rtos::Ticks_t timeout = 0)
+  {
+    return _timer.Stop(timeout);
+  }
+
+  /**
+   * @brief Arms the timer, an armed timer is re-armed.
+   * @param[in] timer The timer.
+   * @param[in] delay The time until the expiry, rounded up to the next wheel tick.
+   * @param[in] period The time between the following expiries, 0 for a one-shot timer.
+   */
+  void Arm(WheelTimer& timer, rtos::Ticks_t delay, rtos::Ticks_t period = 0)
+  {
+    LockGuard<SpinLock> guard {_lock};
+
+    if (timer._armed.load(std::memory_order_relaxed))
+    {
+      Unlink(timer);
+      --_count;
+    }
+
+    timer._expiry = _now + ToWheelTicks(delay);
+    timer._period = (0 < period) ? ToWheelTicks(period) : 0;
+    timer._armed.store(true, std::memory_order_relaxed);
+    Insert(timer);
+    ++_count;
+  }
+
+  /**
+   * @brief Arms the timer, an armed timer is re-armed.
+   * @param[in] timer The timer.
+   * @param[in] delay The duration until the expiry, rounded up to the next wheel tick.
+   */
+  template <typename REP, typename PERIOD>
+  void Arm(WheelTimer& timer, const std::chrono::duration<REP, PERIOD>& delay)
+  {
+    Arm(timer, rtos::ToTicks(delay));
+  }
+
+  /**
+   * @brief Disarms the timer.
+   * @param[in] timer The timer.
+   * @returns true if the timer was armed, false if it was not armed or its callback is already due.
+   */
+  bool Cancel(WheelTimer& timer)
+  {
+    LockGuard<SpinLock> guard {_lock};
+
+    if (!timer._armed.load(std::memory_order_relaxed))
+    {
+      return false;
+    }
+
+    Unlink(timer);
+    timer._armed.store(false, std::memory_order_relaxed);
+    --_count;
+    return true;
+  }
+
+  /**
+   * @returns the number of armed timers.
+   */
+  size_t GetCount() const
+  {
+    LockGuard<SpinLock> guard {_lock};
+    return _count;
+  }
+
+  /**
+   * @returns the duration of a wheel tick.
+   */
+  rtos::Ticks_t GetResolution() const
+  {
+    return _resolution;
+  }
+
+  /**
+   * @returns the number of wheel ticks covered by the levels, longer delays are re-cascaded from the last level.
+   */
+  static constexpr uint64_t GetRange()
+  {
+    return (static_cast<uint64_t>(1) << (SLOT_BITS * LEVELS));
+  }
+
+  private:
+  static constexpr size_t slotCount {static_cast<size_t>(1) << SLOT_BITS};
+  static constexpr uint64_t slotMask {slotCount - 1U};
+
+  uint32_t ToWheelTicks(rtos::Ticks_t ticks) const
+  {
+    const uint32_t wheelTicks = (ticks / _resolution) + ((0 != (ticks % _resolution)) ? 1U : 0U);
+    return (0 < wheelTicks) ? wheelTicks : 1U;
+  }
+
+  // Links the timer into the slot of the lowest level covering its expiry, to be called with the lock held.
+  void Insert(WheelTimer& timer)
+  {
+    size_t level {0};
+    uint64_t slot {0};
+
+    // The lowest level, whose next higher level slot contains both now and the expiry.
+    while ((level < (LEVELS - 1U)) && ((timer._expiry >> (SLOT_BITS * (level + 1U))) != (_now >> (SLOT_BITS * (level + 1U)))))
+    {
+      ++level;
+    }
+
+    const uint64_t expirySlot = timer._expiry >> (SLOT_BITS * level);
+    const uint64_t nowSlot = _now >> (SLOT_BITS * level);
+    if ((expirySlot - nowSlot) < slotCount)
+    {
+      slot = expirySlot & slotMask;
+    }
+    else
+    {
+      // Beyond the range: Park the timer in the last slot to be cascaded, it is re-checked then.
+      slot = (nowSlot - 1U) & slotMask;
+    }
+
+    WheelTimer*& head = _slots[level][slot];
+    timer._prev = nullptr;
+    timer._next = head;
+    if (nullptr != head)
+    {
+      head->_prev = &timer;
+    }
+    head = &timer;
+    timer._level = static_cast<uint8_t>(level);
+    timer._slot = static_cast<uint8_t>(slot);
+  }
+
+  void Unlink(WheelTimer& timer)
+  {
+    if (nullptr != timer._prev)
+    {
+      timer._prev->_next = timer._next;
+    }
+    else
+    {
+      _slots[timer._level][timer._slot] = timer._next;
+    }
+
+    if (nullptr != timer._next)
+    {
+      timer._next->_prev = timer._prev;
+    }
+  }
+
+  // The callback of the kernel timer, advances the wheel by one tick.
+  void OnTick()
+  {
+    uint64_t now {0};
+    {
+      LockGuard<SpinLock> guard {_lock};
+      now = ++_now;
+    }
+
+    // Cascade the higher levels first, so their timers reach the first level before it is processed.
+    for (size_t level = LEVELS - 1U; level > 0; --level)
+    {
+      const uint64_t lowerMask = (static_cast<uint64_t>(1) << (SLOT_BITS * level)) - 1U;
+      if (0 == (now & lowerMask))
+      {
+        Cascade(level, (now >> (SLOT_BITS * level)) & slotMask);
+      }
+    }
+
+    Expire(now & slotMask);
+  }
+
+  // Moves the timers of the slot into the lower levels.
+  void Cascade(size_t level, uint64_t slot)
+  {
+    for (;;)
+    {
+      LockGuard<SpinLock> guard {_lock};
+
+      WheelTimer* const timer = _slots[level][slot];
+      if (nullptr == timer)
+      {
+        return;
+      }
+
+      Unlink(*timer);
+      Insert(*timer);
+    }
+  }
+
+  // Calls the callbacks of the due timers of the first level slot, a single timer per locked section.
+  void Expire(uint64_t slot)
+  {
+    for (;;)
+    {
+      WheelTimer* timer {nullptr};
+      {
+        LockGuard<SpinLock> guard {_lock};
+
+        timer = _slots[0][slot];
+        if (nullptr == timer)
+        {
+          return;
+        }
+
+        Unlink(*timer);
+        if (timer->_expiry > _now)
+        {
+          // Parked beyond the range, not due yet.
+          Insert(*timer);
+          continue;
+        }
+
+        if (0 < timer->_period)
+        {
+          timer->_expiry = _now + timer->_period;
+          Insert(*timer);
+        }
+        else
+        {
+          timer->_armed.store(false, std::memory_order_relaxed);
+          --_count;
+        }
+      }
+
+      timer->_callback();
+    }
+  }
+
+  private:
+  const rtos::Ticks_t _resolution;          /** The duration of a wheel tick. */
+  mutable rtos::SpinLock _lock;             /** Protects the slots and the timers linked into them. */
+  WheelTimer* _slots[LEVELS][slotCount];    /** The first timer of each slot. */
+  uint64_t _now;                            /** The current wheel tick. */
+  size_t _count;                            /** The number of armed timers. */
+  rtos::Timer _timer;                       /** The kernel timer, which advances the wheel. Destroyed first, so OnTick() does not run on a destroyed wheel. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_FD524B4697F641BABF78FFDC33FB5462
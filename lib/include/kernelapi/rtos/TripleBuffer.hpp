@@ -0,0 +1,233 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_45B89B7F9EB446428F92581D651BDAC1
+#define HEADER_45B89B7F9EB446428F92581D651BDAC1
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <kernelapi/rtos/CacheLine.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The TripleBuffer class publishes the latest value of a single producer to one or more consumers without any lock.
+ *        The producer writes into a back buffer and publishes it by atomically swapping the index of the latest buffer.
+ *        A consumer pins the latest buffer while reading it in place, so neither the producer nor the consumers block each other.
+ *        Values published while nobody reads are simply overwritten, consumers always see the newest complete value.
+ *
+ * @note Only one task may write at a time. At most \a READERS consumers may hold a Snapshot at the same time,
+ *       one back buffer is reserved for each of them, i.e. the TripleBuffer holds READERS + 2 buffers.
+ *
+ * @code
+ *   rtos::TripleBuffer<State> state;
+ *
+ *   // Producer
+ *   State& next = state.BeginWrite();
+ *   next.speed = ...;
+ *   state.Publish();
+ *
+ *   // Consumer
+ *   const auto snapshot = state.Read();
+ *   Use(snapshot->speed);
+ * @endcode
+ *
+ * @tparam T The type of the value, it has to be default constructible.
+ * @tparam READERS The maximum number of consumers reading at the same time.
+ */
+template <typename T, size_t READERS = 1>
+class TripleBuffer
+{
+  static_assert((0 < READERS) && (READERS < 254), "READERS has to be in the range of 1 to 253");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "The TripleBuffer needs lock-free atomics");
+
+  public:
+  /**
+   * @brief The Snapshot class pins a published buffer while it is read in place.
+   *        The buffer is released, when the Snapshot is destroyed.
+   */
+  class Snapshot
+  {
+    // Make this class non-copyable
+    public:
+    Snapshot(const Snapshot& other) = delete;
+    Snapshot& operator=(const Snapshot& other) = delete;
+
+    public:
+    Snapshot(Snapshot&& other) :
+      _buffer{other._buffer},
+      _index{other._index},
+      _sequence{other._sequence}
+    {
+      other._buffer = nullptr;
+    }
+
+    ~Snapshot()
+    {
+      if (nullptr != _buffer)
+      {
+        _buffer->Release(_index);
+      }
+    }
+
+    public:
+    const T& operator*() const
+    {
+      return _buffer->_buffers[_index];
+    }
+
+    const T* operator->() const
+    {
+      return &_buffer->_buffers[_index];
+    }
+
+    /**
+     * @returns the publication sequence number of the value, it increments with each Publish().
+     */
+    uint32_t GetSequence() const
+    {
+      return _sequence;
+    }
+
+    private:
+    friend class TripleBuffer;
+
+    Snapshot(const TripleBuffer* buffer, uint32_t index, uint32_t sequence) :
+      _buffer{buffer},
+      _index{index},
+      _sequence{sequence}
+    {}
+
+    const TripleBuffer* _buffer; /** The owning TripleBuffer, nullptr if moved. */
+    uint32_t _index;             /** The index of the pinned buffer. */
+    uint32_t _sequence;          /** The publication sequence number of the pinned buffer. */
+  };
+
+  // Make this class non-copyable
+  public:
+  TripleBuffer(const TripleBuffer& other) = delete;
+  TripleBuffer& operator=(const TripleBuffer& other) = delete;
+
+  public:
+  /**
+   * The default constructor.
+   * The initial value is a default constructed T with sequence number 0.
+   */
+  TripleBuffer() :
+    _latest{0},
+    _readers{},
+    _writeIndex{1},
+    _buffers{}
+  {}
+
+  public:
+  /**
+   * @brief Returns the back buffer to be written by the producer.
+   *         The back buffer contains an older value, it is not cleared.
+   * @returns the back buffer, it is published by Publish().
+   */
+  T& BeginWrite()
+  {
+    return _buffers[_writeIndex];
+  }
+
+  /**
+   * @brief Publishes the back buffer as the latest value and selects a new back buffer,
+   *        which is neither the latest nor pinned by a consumer.
+   */
+  void Publish()
+  {
+    const uint32_t latest = _latest.load(std::memory_order_relaxed);
+    const uint32_t sequence = (latest >> indexBits) + 1U;
+    _latest.store((sequence << indexBits) | _writeIndex, std::memory_order_seq_cst);
+
+    // A free buffer always exists, as long as no more than READERS consumers hold a Snapshot.
+    for (uint32_t index = 0;; index = (index + 1U) % bufferCount)
+    {
+      if ((index != _writeIndex) && (0 == _readers[index].load(std::memory_order_seq_cst)))
+      {
+        _writeIndex = index;
+        break;
+      }
+    }
+  }
+
+  /**
+   * @brief Copies \a value into the back buffer and publishes it.
+   * @param[in] value The new value.
+   */
+  void Write(const T& value)
+  {
+    BeginWrite() = value;
+    Publish();
+  }
+
+  /**
+   * @brief Pins the latest buffer for reading in place.
+   * @returns the Snapshot of the latest value.
+   */
+  Snapshot Read() const
+  {
+    for (;;)
+    {
+      const uint32_t latest = _latest.load(std::memory_order_seq_cst);
+      const uint32_t index = latest & indexMask;
+
+      _readers[index].fetch_add(1U, std::memory_order_seq_cst);
+
+      // The producer may have reused the buffer before it was pinned, retry with the new latest buffer.
+      if (latest == _latest.load(std::memory_order_seq_cst))
+      {
+        return Snapshot{this, index, latest >> indexBits};
+      }
+
+      Release(index);
+    }
+  }
+
+  /**
+   * @brief Copies the latest value.
+   * @param[out] value The copy of the latest value.
+   * @returns the publication sequence number of the value.
+   */
+  uint32_t ReadCopy(T& value) const
+  {
+    const Snapshot snapshot = Read();
+    value = *snapshot;
+    return snapshot.GetSequence();
+  }
+
+  /**
+   * @returns the sequence number of the latest value, it increments with each Publish().
+   *          Consumers may compare it to decide whether a new value is available, it wraps around after 2^24 publications.
+   */
+  uint32_t GetSequence() const
+  {
+    return _latest.load(std::memory_order_acquire) >> indexBits;
+  }
+
+  private:
+  void Release(uint32_t index) const
+  {
+    _readers[index].fetch_sub(1U, std::memory_order_release);
+  }
+
+  private:
+  static constexpr uint32_t bufferCount {READERS + 2U};
+  static constexpr uint32_t indexBits {8U};
+  static constexpr uint32_t indexMask {(1U << indexBits) - 1U};
+
+  alignas(rtos::cacheLineSize) std::atomic<uint32_t> _latest; /** The sequence number and index of the latest buffer. */
+  alignas(rtos::cacheLineSize) mutable std::atomic<uint32_t> _readers[bufferCount]; /** The number of consumers pinning each buffer. */
+  alignas(rtos::cacheLineSize) uint32_t _writeIndex; /** The index of the back buffer, only accessed by the producer. */
+  T _buffers[bufferCount]; /** The buffers. */
+};
+
+} // namespace rtos
+
+#endif // HEADER_45B89B7F9EB446428F92581D651BDAC1
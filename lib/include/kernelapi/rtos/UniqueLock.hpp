@@ -0,0 +1,255 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_FEA31C834527475E890DCE52B982E6C3
+#define HEADER_FEA31C834527475E890DCE52B982E6C3
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/MutexTraits.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+/**
+ * @brief The class UniqueLock is a movable mutex wrapper that provides a RAII-style mechanism for owning a mutex.
+ *        Contrary to the LockGuard, the ownership of the lock can be transferred to another UniqueLock by moving it,
+ *        e.g. to return a locked mutex from a function, without unlocking and relocking the mutex.
+ *        When a UniqueLock, which owns the lock, is destructed, the mutex is released.
+ *        The UniqueLock class is non-copyable.
+ * @note The UniqueLock was inspired by the C++11 implementation of unique_lock.
+ */
+template <typename MUTEX>
+class UniqueLock
+{
+  static_assert(rtos::isLockable<MUTEX>, "MUTEX has to provide Lock(), TryLock() and Unlock(), see MutexTraits.hpp");
+
+  // Make this class non-copyable
+  public:
+  UniqueLock(const UniqueLock& other) = delete;
+  UniqueLock& operator=(const UniqueLock& other) = delete;
+
+  public:
+  /**
+   * Creates a UniqueLock, which is not associated with a mutex.
+   */
+  UniqueLock() noexcept :
+    _mutex(nullptr), _isLocked(false)
+  {}
+
+  /**
+   * Stores a reference to mutex and invokes mutex.Lock() for locking the mutex.
+   * @note Does not return before the mutex was locked.
+   * @param[in] mutex Reference of the mutex to be stored.
+   */
+  explicit UniqueLock(MUTEX& mutex) :
+    _mutex(&mutex), _isLocked(false)
+  {
+    Lock();
+  }
+
+  /**
+   * Stores a reference to mutex but does not lock the mutex.
+   *        The mutex can be locked by the methods Lock(), TryLock() or TryLockFor()
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @note DeferLock tag parameter is used to select non-locking version of the constructor.
+   */
+  UniqueLock(MUTEX& mutex, DeferLock) noexcept :
+    _mutex(&mutex), _isLocked(false)
+  {}
+
+  /**
+   * Stores the reference to the given mutex and tries to lock the mutex.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @note TryToLock tag parameter used to select try-lock version of the constructor.
+   * @note Returns immediately, even if the mutex was not locked! You can call OwnsLock() to verify if the mutex was locked.
+   */
+  UniqueLock(MUTEX& mutex, TryToLock) :
+    _mutex(&mutex), _isLocked(false)
+  {
+    TryLock();
+  }
+
+  /**
+   * Stores the reference to the given mutex and tries to lock it.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @param[in] timeout maximum time to block for.
+   * @note To verify the mutex was locked, call OwnsLock()
+   */
+  UniqueLock(MUTEX& mutex, rtos::Ticks_t timeout) :
+    _mutex(&mutex), _isLocked(false)
+  {
+    TryLockFor(timeout);
+  }
+
+  /**
+   * Stores the reference to the given mutex and tries to lock it.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] mutex Reference of the mutex to be stored.
+   * @param[in] timeout maximum duration to block for, rounded up to the next tick.
+   * @note To verify the mutex was locked, call OwnsLock()
+   */
+  template <typename REP, typename PERIOD>
+  UniqueLock(MUTEX& mutex, const std::chrono::duration<REP, PERIOD>& timeout) :
+    UniqueLock(mutex, rtos::ToTicks(timeout))
+  {}
+
+  /**
+   * Takes over the mutex and the lock ownership of \a other, without calling the mutex.
+   * @param[in] other The UniqueLock to move from, it is not associated with a mutex afterwards.
+   */
+  UniqueLock(UniqueLock&& other) noexcept :
+    _mutex(other._mutex), _isLocked(other._isLocked)
+  {
+    other._mutex = nullptr;
+    other._isLocked = false;
+  }
+
+  /**
+   * Unlocks the currently owned mutex, then takes over the mutex and the lock ownership of \a other.
+   * @param[in] other The UniqueLock to move from, it is not associated with a mutex afterwards.
+   * @returns a reference to this UniqueLock.
+   */
+  UniqueLock& operator=(UniqueLock&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Unlock();
+      _mutex = other._mutex;
+      _isLocked = other._isLocked;
+      other._mutex = nullptr;
+      other._isLocked = false;
+    }
+
+    return *this;
+  }
+
+  /**
+   * Unlocks the mutex, when it owns the lock.
+   */
+  ~UniqueLock()
+  {
+    Unlock();
+  }
+
+  /**
+   * Lock the mutex, wait until mutex is available.
+   * @note Does nothing, if the UniqueLock is not associated with a mutex.
+   */
+  void Lock()
+  {
+    if ((nullptr != _mutex) && !OwnsLock())
+    {
+      _mutex->Lock();
+      _isLocked = true;
+    }
+  }
+
+  /**
+   * Tries to lock the mutex, does not wait if the mutex is not available.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLock()
+  {
+    if ((nullptr != _mutex) && !OwnsLock())
+    {
+      _isLocked = _mutex->TryLock();
+    }
+
+    return _isLocked;
+  }
+
+  /**
+   * Tries to lock the mutex.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] timeout maximum time to block for.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  bool TryLockFor(rtos::Ticks_t timeout)
+  {
+    if ((nullptr != _mutex) && !OwnsLock())
+    {
+      _isLocked = _mutex->TryLockFor(timeout);
+    }
+
+    return _isLocked;
+  }
+
+  /**
+   * Tries to lock the mutex.
+   * Blocks until specified \a timeout has been reached or the lock is acquired.
+   * @param[in] timeout maximum duration to block for, rounded up to the next tick.
+   * @returns true, if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    return TryLockFor(rtos::ToTicks(timeout));
+  }
+
+  /**
+   * Unlock the mutex, if it was locked before.
+   */
+  void Unlock() noexcept
+  {
+    if (OwnsLock())
+    {
+      _isLocked = false;
+      _mutex->Unlock();
+    }
+  }
+
+  /**
+   * Disassociates the mutex without unlocking it.
+   * @returns a pointer to the associated mutex, nullptr if there was no associated mutex.
+   * @note The caller is responsible for unlocking the mutex, if it was locked.
+   */
+  MUTEX* Release() noexcept
+  {
+    MUTEX* const mutex = _mutex;
+    _mutex = nullptr;
+    _isLocked = false;
+    return mutex;
+  }
+
+  /**
+   * Exchanges the mutex and the lock ownership with \a other.
+   * @param[in,out] other The UniqueLock to swap with.
+   */
+  void Swap(UniqueLock& other) noexcept
+  {
+    MUTEX* const mutex = _mutex;
+    const bool isLocked = _isLocked;
+    _mutex = other._mutex;
+    _isLocked = other._isLocked;
+    other._mutex = mutex;
+    other._isLocked = isLocked;
+  }
+
+  /**
+   * @returns a pointer to the associated mutex, nullptr if there is no associated mutex.
+   */
+  MUTEX* GetMutex() const noexcept
+  {
+    return _mutex;
+  }
+
+  /**
+   * @returns true, when it owns the lock, false otherwise.
+   */
+  bool OwnsLock() const noexcept
+  {
+    return _isLocked;
+  }
+
+  private:
+  MUTEX* _mutex;
+  bool _isLocked;
+};
+
+} // namespace rtos
+
+#endif // HEADER_FEA31C834527475E890DCE52B982E6C3
@@ -0,0 +1,183 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_7A83EC5D009549DEAAF29B1180999C23
+#define HEADER_7A83EC5D009549DEAAF29B1180999C23
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <kernelapi/rtos/CacheLine.hpp>
+
+namespace rtos
+{
+
+namespace detail
+{
+
+/**
+ * @brief The WorkStealingDeque class is a bounded, lock-free Chase-Lev deque.
+ *        The owner pushes and pops at the bottom (LIFO, cache friendly), any other task steals from the top (FIFO).
+ *        Only the owner and the thieves competing for the last item synchronize with a compare-and-swap.
+ *
+ * @note Only the owner task may call Push() and Pop()! Steal() may be called by any task.
+ *
+ * @tparam T The type of the items, it has to be trivially copyable.
+ * @tparam N The capacity, must be a power of two.
+ */
+template <typename T, size_t N>
+class WorkStealingDeque
+{
+  static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque requires a trivially copyable type T");
+  static_assert((1 < N) && (0 == (N & (N - 1))), "The capacity N has to be a power of two");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free, "The deque needs lock-free atomics");
+
+  // Make this class non-copyable
+  public:
+  WorkStealingDeque(const WorkStealingDeque& other) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+
+  public:
+  WorkStealingDeque() :
+    _top{0},
+    _bottom{0},
+    _slots{}
+  {}
+
+  public:
+  /**
+   * @returns the number of items the deque can hold.
+   */
+  static constexpr size_t GetCapacity()
+  {
+    return N;
+  }
+
+  /**
+   * @returns true if the deque does not contain any item, the value may be outdated when another task is active.
+   */
+  bool IsEmpty() const
+  {
+    return (0 >= static_cast<int32_t>(_bottom.load(std::memory_order_acquire) - _top.load(std::memory_order_acquire)));
+  }
+
+  /**
+   * @brief Copies the item to the bottom of the deque, to be called by the owner.
+   * @param[in] item The item to be copied.
+   * @returns true if the item was pushed, false if the deque is full.
+   */
+  bool Push(const T& item)
+  {
+    const uint32_t bottom = _bottom.load(std::memory_order_relaxed);
+    const uint32_t top = _top.load(std::memory_order_acquire);
+    if ((bottom - top) >= N)
+    {
+      return false;
+    }
+
+    Store(_slots[bottom & mask], item);
+    std::atomic_thread_fence(std::memory_order_release);
+    _bottom.store(bottom + 1U, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Takes the newest item from the bottom of the deque, to be called by the owner.
+   * @param[out] item The item.
+   * @returns true if an item was popped, false if the deque is empty or a thief took the last item.
+   */
+  bool Pop(T& item)
+  {
+    const uint32_t bottom = _bottom.load(std::memory_order_relaxed) - 1U;
+    _bottom.store(bottom, std::memory_order_relaxed);
+
+    // Pairs with the fence in Steal(): Either the thief sees the reserved item or we see the advanced top.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint32_t top = _top.load(std::memory_order_relaxed);
+
+    const int32_t count = static_cast<int32_t>(bottom - top);
+    if (0 > count)
+    {
+      _bottom.store(bottom + 1U, std::memory_order_relaxed);
+      return false;
+    }
+
+    Load(_slots[bottom & mask], item);
+    if (0 < count)
+    {
+      return true;
+    }
+
+    // The last item, race against the thieves.
+    const bool popped = _top.compare_exchange_strong(top, top + 1U, std::memory_order_seq_cst, std::memory_order_relaxed);
+    _bottom.store(bottom + 1U, std::memory_order_relaxed);
+    return popped;
+  }
+
+  /**
+   * @brief Takes the oldest item from the top of the deque, to be called by any task except the owner.
+   * @param[out] item The item.
+   * @returns true if an item was stolen, false if the deque is empty or another task took the item.
+   */
+  bool Steal(T& item)
+  {
+    uint32_t top = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const uint32_t bottom = _bottom.load(std::memory_order_acquire);
+
+    if (0 >= static_cast<int32_t>(bottom - top))
+    {
+      return false;
+    }
+
+    // The owner may overwrite the slot only after top has moved on, thus the copy is discarded if the compare-and-swap fails.
+    Load(_slots[top & mask], item);
+    return _top.compare_exchange_strong(top, top + 1U, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+
+  private:
+  static constexpr size_t mask {N - 1};
+  static constexpr size_t wordCount {(sizeof(T) + sizeof(uint32_t) - 1U) / sizeof(uint32_t)};
+
+  struct Slot
+  {
+    std::atomic<uint32_t> words[wordCount]; /** The item, stored as words. */
+  };
+
+  // The item is copied word by word with relaxed atomics, thus the copy of a thief racing with the owner is not a data race.
+  static void Load(const Slot& slot, T& item)
+  {
+    uint32_t words[wordCount];
+    for (size_t i = 0; i < wordCount; ++i)
+    {
+      words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::memcpy(&item, words, sizeof(T));
+  }
+
+  static void Store(Slot& slot, const T& item)
+  {
+    uint32_t words[wordCount] {};
+    std::memcpy(words, &item, sizeof(T));
+    for (size_t i = 0; i < wordCount; ++i)
+    {
+      slot.words[i].store(words[i], std::memory_order_relaxed);
+    }
+  }
+
+  private:
+  alignas(rtos::cacheLineSize) std::atomic<uint32_t> _top;    /** The index of the oldest item, advanced by the thieves. */
+  alignas(rtos::cacheLineSize) std::atomic<uint32_t> _bottom; /** The index of the next item to be pushed, written by the owner. */
+  Slot _slots[N];                                             /** The items. */
+};
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_7A83EC5D009549DEAAF29B1180999C23
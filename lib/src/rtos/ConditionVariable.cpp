@@ -0,0 +1,196 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/ConditionVariable.hpp>
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+namespace
+{
+
+// Use a dedicated notification index if available, so the condition variable does not interfere with other notifications.
+#if defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+constexpr UBaseType_t notifyIndex {configTASK_NOTIFICATION_ARRAY_ENTRIES - 1};
+
+void Notify(TaskHandle_t task)
+{
+  xTaskNotifyGiveIndexed(task, notifyIndex);
+}
+
+bool TakeNotification(rtos::Ticks_t timeout)
+{
+  return (0 != ulTaskNotifyTakeIndexed(notifyIndex, pdTRUE, timeout));
+}
+#else
+void Notify(TaskHandle_t task)
+{
+  xTaskNotifyGive(task);
+}
+
+bool TakeNotification(rtos::Ticks_t timeout)
+{
+  return (0 != ulTaskNotifyTake(pdTRUE, timeout));
+}
+#endif
+
+} // namespace
+
+ConditionVariable::ConditionVariable() :
+  _lock{},
+  _head{nullptr},
+  _tail{nullptr}
+{
+}
+
+void ConditionVariable::NotifyOne()
+{
+  TaskHandle_t task {nullptr};
+
+  {
+    LockGuard<SpinLock> guard {_lock};
+    Waiter* const waiter = _head;
+    if (nullptr == waiter)
+    {
+      return;
+    }
+
+    _head = waiter->next;
+    if (nullptr == _head)
+    {
+      _tail = nullptr;
+    }
+
+    // The waiter stays valid until its task got the notification.
+    task = waiter->task;
+    waiter->notified = true;
+  }
+
+  Notify(task);
+}
+
+void ConditionVariable::NotifyAll()
+{
+  Waiter* waiter {nullptr};
+
+  {
+    LockGuard<SpinLock> guard {_lock};
+    waiter = _head;
+    _head = nullptr;
+    _tail = nullptr;
+
+    for (Waiter* it = waiter; nullptr != it; it = it->next)
+    {
+      it->notified = true;
+    }
+  }
+
+  // A waiter may return as soon as its task got the notification, so read the waiter before notifying.
+  while (nullptr != waiter)
+  {
+    Waiter* const next = waiter->next;
+    Notify(waiter->task);
+    waiter = next;
+  }
+}
+
+void ConditionVariable::Enqueue(Waiter& waiter)
+{
+  waiter.task = xTaskGetCurrentTaskHandle();
+  waiter.next = nullptr;
+  waiter.notified = false;
+
+  LockGuard<SpinLock> guard {_lock};
+  if (nullptr == _tail)
+  {
+    _head = &waiter;
+  }
+  else
+  {
+    _tail->next = &waiter;
+  }
+  _tail = &waiter;
+}
+
+bool ConditionVariable::Block(Waiter& waiter, rtos::Ticks_t timeout)
+{
+  TimeOut_t timeOutState;
+  TickType_t remaining {timeout};
+  vTaskSetTimeOutState(&timeOutState);
+
+  for (;;)
+  {
+    const bool taken = TakeNotification(remaining);
+
+    // Without a dedicated notification index, a notification of another purpose wakes up the task as well.
+    // Then keep waiting for the remaining time, the waiter is still linked.
+    const bool expired = !taken || (pdTRUE == xTaskCheckForTimeOut(&timeOutState, &remaining));
+
+    bool notified {false};
+
+    {
+      LockGuard<SpinLock> guard {_lock};
+      notified = waiter.notified;
+
+      // Remove the waiter when it timed out, before it goes out of scope.
+      if (!notified && expired)
+      {
+        Unlink(waiter);
+      }
+    }
+
+    // Notified concurrently with the timeout: consume the notification, which is given right after, so it does not wake up a later wait.
+    if (notified && !taken)
+    {
+      while (!TakeNotification(GetMaxDelay()))
+      {
+      }
+    }
+
+    if (notified || expired)
+    {
+      return notified;
+    }
+  }
+}
+
+void ConditionVariable::Unlink(Waiter& waiter)
+{
+  Waiter* previous {nullptr};
+  for (Waiter* it = _head; nullptr != it; previous = it, it = it->next)
+  {
+    if (&waiter == it)
+    {
+      if (nullptr == previous)
+      {
+        _head = it->next;
+      }
+      else
+      {
+        previous->next = it->next;
+      }
+
+      if (_tail == it)
+      {
+        _tail = previous;
+      }
+      return;
+    }
+  }
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
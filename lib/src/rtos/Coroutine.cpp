@@ -0,0 +1,165 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <kernelapi/rtos/Coroutine.hpp>
+#include <kernelapi/rtos/Isr.hpp>
+
+#if defined(KERNELAPI_HAS_COROUTINES)
+
+namespace rtos
+{
+
+Executor::Executor(rtos::Ticks_t pollInterval) :
+  _pollInterval{(0 < pollInterval) ? pollInterval : 1},
+  _head{nullptr},
+  _tail{nullptr},
+  _count{0},
+  _polling{0},
+  _task{nullptr}
+{}
+
+Executor::~Executor()
+{
+  detail::AwaitNode* node = _head;
+  _head = nullptr;
+  _tail = nullptr;
+  _count = 0;
+  _polling = 0;
+
+  while (nullptr != node)
+  {
+    // The node is part of the coroutine frame, which is freed by destroying it.
+    detail::AwaitNode* const next = node->next;
+    node->handle.destroy();
+    node = next;
+  }
+}
+
+bool Executor::Spawn(Coroutine&& coroutine)
+{
+  if (!coroutine.IsValid())
+  {
+    return false;
+  }
+
+  const Coroutine::Handle handle = std::exchange(coroutine._handle, nullptr);
+  Coroutine::promise_type& promise = handle.promise();
+  promise.executor = this;
+  promise.node.handle = handle;
+  promise.node.poll = [](detail::AwaitNode&) { return true; };
+  Append(promise.node);
+  return true;
+}
+
+void Executor::Run()
+{
+  _task.store(xTaskGetCurrentTaskHandle());
+
+  for (;;)
+  {
+    if (!RunOnce())
+    {
+      // Nothing to poll: Only a wakeup lets a coroutine continue.
+      ulTaskNotifyTake(pdTRUE, (0 < _polling) ? _pollInterval : GetMaxDelay());
+    }
+  }
+}
+
+bool Executor::RunOnce()
+{
+  // Coroutines suspending while the list is processed are appended to a new list, they are polled by the next call.
+  detail::AwaitNode* node = _head;
+  _head = nullptr;
+  _tail = nullptr;
+  _count = 0;
+  _polling = 0;
+
+  bool resumed {false};
+  while (nullptr != node)
+  {
+    // The node is part of the coroutine frame, which may be freed by resuming it.
+    detail::AwaitNode* const next = node->next;
+    if (node->poll(*node))
+    {
+      resumed = true;
+      node->handle.resume();
+    }
+    else
+    {
+      Append(*node);
+    }
+    node = next;
+  }
+
+  return resumed;
+}
+
+void Executor::Wake()
+{
+  const TaskHandle_t task = _task.load();
+  if (nullptr != task)
+  {
+    xTaskNotifyGive(task);
+  }
+}
+
+void Executor::WakeFromISR(BaseType_t* higherPriorityTaskWoken)
+{
+  const TaskHandle_t task = _task.load();
+  if (nullptr == task)
+  {
+    return;
+  }
+
+  BaseType_t woken {pdFALSE};
+  vTaskNotifyGiveFromISR(task, &woken);
+
+  detail::YieldFromISR(woken, higherPriorityTaskWoken);
+}
+
+size_t Executor::GetCount() const
+{
+  return _count;
+}
+
+TaskHandle_t Executor::GetTaskHandle() const
+{
+  return _task.load();
+}
+
+void Executor::Suspend(detail::AwaitNode& node, Coroutine::Handle handle)
+{
+  node.handle = handle;
+  handle.promise().executor->Append(node);
+}
+
+void Executor::Append(detail::AwaitNode& node)
+{
+  node.next = nullptr;
+  if (nullptr == _tail)
+  {
+    _head = &node;
+  }
+  else
+  {
+    _tail->next = &node;
+  }
+  _tail = &node;
+
+  ++_count;
+  if (node.needsPolling)
+  {
+    ++_polling;
+  }
+}
+
+} // namespace rtos
+
+#endif // KERNELAPI_HAS_COROUTINES
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
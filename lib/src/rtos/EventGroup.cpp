@@ -0,0 +1,114 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cassert>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/event_groups.h>
+
+#include <kernelapi/rtos/EventGroup.hpp>
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+
+namespace rtos
+{
+
+namespace
+{
+
+// The kernel stores its control bits in the upper bits, using them corrupts the event group or the waiting tasks.
+constexpr bool IsUsable(EventBits_t bits)
+{
+  return (0 == (bits & ~EventGroup::GetUsableBits()));
+}
+
+} // namespace
+
+EventGroup::EventGroup() :
+  _storage{},
+  _handle{nullptr}
+{
+  // Does not fail, when a valid storage buffer is given.
+  _handle = xEventGroupCreateStatic(&_storage);
+  assert(_handle && "Failed to create the event group");
+}
+
+EventGroup::~EventGroup()
+{
+  // No memory is freed for static event groups, but the kernel unblocks the waiting tasks.
+  vEventGroupDelete(_handle);
+}
+
+bool EventGroup::IsValid() const
+{
+  return (nullptr != _handle);
+}
+
+EventBits_t EventGroup::Set(EventBits_t bits)
+{
+  assert(IsUsable(bits) && "The upper bits are reserved by the kernel");
+  return xEventGroupSetBits(_handle, bits);
+}
+
+bool EventGroup::SetFromISR(EventBits_t bits, BaseType_t* higherPriorityTaskWoken)
+{
+  assert(IsUsable(bits) && "The upper bits are reserved by the kernel");
+  BaseType_t woken {pdFALSE};
+  const BaseType_t ret = xEventGroupSetBitsFromISR(_handle, bits, &woken);
+
+  detail::YieldFromISR(woken, higherPriorityTaskWoken);
+
+  return (pdPASS == ret);
+}
+
+EventBits_t EventGroup::Clear(EventBits_t bits)
+{
+  assert(IsUsable(bits) && "The upper bits are reserved by the kernel");
+  return xEventGroupClearBits(_handle, bits);
+}
+
+bool EventGroup::ClearFromISR(EventBits_t bits)
+{
+  assert(IsUsable(bits) && "The upper bits are reserved by the kernel");
+  return (pdPASS == xEventGroupClearBitsFromISR(_handle, bits));
+}
+
+EventBits_t EventGroup::Get() const
+{
+  return xEventGroupGetBits(_handle);
+}
+
+EventBits_t EventGroup::GetFromISR() const
+{
+  return xEventGroupGetBitsFromISR(_handle);
+}
+
+EventBits_t EventGroup::WaitAny(EventBits_t bits, rtos::Ticks_t timeout, bool clearOnExit)
+{
+  assert(IsUsable(bits) && "The upper bits are reserved by the kernel");
+  const EventBits_t ret = xEventGroupWaitBits(_handle, bits, clearOnExit ? pdTRUE : pdFALSE, pdFALSE, timeout);
+  return (ret & bits);
+}
+
+bool EventGroup::WaitAll(EventBits_t bits, rtos::Ticks_t timeout, bool clearOnExit)
+{
+  assert(IsUsable(bits) && "The upper bits are reserved by the kernel");
+  const EventBits_t ret = xEventGroupWaitBits(_handle, bits, clearOnExit ? pdTRUE : pdFALSE, pdTRUE, timeout);
+  return (bits == (ret & bits));
+}
+
+bool EventGroup::Sync(EventBits_t setBits, EventBits_t waitBits, rtos::Ticks_t timeout)
+{
+  assert(IsUsable((setBits | waitBits)) && "The upper bits are reserved by the kernel");
+  const EventBits_t ret = xEventGroupSync(_handle, setBits, waitBits, timeout);
+  return (waitBits == (ret & waitBits));
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
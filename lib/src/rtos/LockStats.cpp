@@ -0,0 +1,147 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <atomic>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+
+#include <kernelapi/rtos/LockStats.hpp>
+#include <kernelapi/rtos/LockWatchdog.hpp>
+#include <kernelapi/rtos/StatsRegistry.hpp>
+
+namespace rtos
+{
+
+namespace
+{
+
+// The global list of lock statistics.
+detail::StatsRegistry<LockStatsRecord, LockStats> registry {};
+
+// ResetLockStats() may reset the maximum concurrently, so it is updated by compare-and-swap.
+void UpdateMax(std::atomic<uint32_t>& max, uint32_t value)
+{
+  uint32_t current = max.load(std::memory_order_relaxed);
+  while ((value > current) && !max.compare_exchange_weak(current, value, std::memory_order_relaxed))
+  {
+  }
+}
+
+} // namespace
+
+LockStatsRecord::LockStatsRecord(const void* lock) :
+  _lock{lock},
+  _acquisitions{0},
+  _contentions{0},
+  _totalWaitTime{0},
+  _maxWaitTime{0},
+  _maxHoldTime{0},
+  _acquiredAt{0},
+  _depth{0},
+  _holderPriority{0},
+  _next{nullptr}
+{
+  registry.Register(*this);
+}
+
+LockStatsRecord::~LockStatsRecord()
+{
+  registry.Unregister(*this);
+}
+
+void LockStatsRecord::OnAcquired(uint32_t startTime, bool contended)
+{
+  const uint32_t now = GetLockStatsTimestamp();
+
+  _acquisitions.fetch_add(1, std::memory_order_relaxed);
+
+  if (contended)
+  {
+    const uint32_t waitTime = now - startTime;
+    _contentions.fetch_add(1, std::memory_order_relaxed);
+    _totalWaitTime.fetch_add(waitTime, std::memory_order_relaxed);
+    UpdateMax(_maxWaitTime, waitTime);
+  }
+
+  // Hold time is measured from the outermost acquisition of a recursive lock.
+  if (0 == _depth++)
+  {
+    _acquiredAt = now;
+    _holderPriority.store(uxTaskPriorityGet(nullptr), std::memory_order_relaxed);
+  }
+}
+
+void LockStatsRecord::OnContended(void* holder)
+{
+  detail::CheckLockPriorityInversion(_lock, static_cast<TaskHandle_t>(holder), _holderPriority.load(std::memory_order_relaxed));
+}
+
+void LockStatsRecord::OnReleased()
+{
+  if ((0 != _depth) && (0 == --_depth))
+  {
+    const uint32_t holdTime = GetLockStatsTimestamp() - _acquiredAt;
+    UpdateMax(_maxHoldTime, holdTime);
+    detail::CheckLockHoldTime(_lock, holdTime, _holderPriority.load(std::memory_order_relaxed));
+  }
+}
+
+LockStats LockStatsRecord::GetStats() const
+{
+  return LockStats{_lock, _acquisitions.load(std::memory_order_relaxed), _contentions.load(std::memory_order_relaxed),
+                   _totalWaitTime.load(std::memory_order_relaxed), _maxWaitTime.load(std::memory_order_relaxed),
+                   _maxHoldTime.load(std::memory_order_relaxed)};
+}
+
+void LockStatsRecord::Reset()
+{
+  _acquisitions.store(0, std::memory_order_relaxed);
+  _contentions.store(0, std::memory_order_relaxed);
+  _totalWaitTime.store(0, std::memory_order_relaxed);
+  _maxWaitTime.store(0, std::memory_order_relaxed);
+  _maxHoldTime.store(0, std::memory_order_relaxed);
+}
+
+uint32_t GetLockStats(LockStats* buffer, uint32_t count, uint32_t first)
+{
+  return registry.Copy(buffer, count, first);
+}
+
+void ResetLockStats()
+{
+  registry.Reset();
+}
+
+void PrintLockStats()
+{
+  // Copy a few records at once, so the registry is locked only briefly and not while printing.
+  constexpr uint32_t bufferSize {8};
+  LockStats buffer[bufferSize];
+  uint32_t first {0};
+  uint32_t copied {0};
+
+  printf("lock,acquisitions,contentions,total_wait,max_wait,max_hold\n");
+
+  do
+  {
+    copied = GetLockStats(buffer, bufferSize, first);
+    for (uint32_t i = 0; i < copied; ++i)
+    {
+      const LockStats& stats = buffer[i];
+      printf("%p,%" PRIu32 ",%" PRIu32 ",%" PRIu64 ",%" PRIu32 ",%" PRIu32 "\n",
+             stats.lock, stats.acquisitions, stats.contentions, stats.totalWaitTime, stats.maxWaitTime, stats.maxHoldTime);
+    }
+    first += copied;
+  }
+  while (bufferSize == copied);
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
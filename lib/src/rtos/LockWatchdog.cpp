@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <atomic>
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/LockWatchdog.hpp>
+
+namespace rtos
+{
+
+namespace
+{
+
+std::atomic<LockWatchdogCallback> watchdogCallback {nullptr};
+std::atomic<uint32_t> watchdogHoldTimeBudget {0};
+
+} // namespace
+
+void SetLockWatchdog(LockWatchdogCallback callback, uint32_t holdTimeBudget)
+{
+  watchdogHoldTimeBudget.store(holdTimeBudget, std::memory_order_relaxed);
+  watchdogCallback.store(callback, std::memory_order_release);
+}
+
+namespace detail
+{
+
+void CheckLockHoldTime(const void* lock, uint32_t holdTime, UBaseType_t holderPriority)
+{
+  const LockWatchdogCallback callback = watchdogCallback.load(std::memory_order_acquire);
+  const uint32_t budget = watchdogHoldTimeBudget.load(std::memory_order_relaxed);
+
+  if ((nullptr == callback) || (0 == budget) || (holdTime <= budget))
+  {
+    return;
+  }
+
+  // The calling task is the holder, its priority is reported as recorded when it acquired the lock, like for PriorityInversion.
+  callback(LockWatchdogEvent{LockWatchdogEventType::HoldTimeExceeded, lock, xTaskGetCurrentTaskHandle(), holderPriority, nullptr, 0, holdTime});
+}
+
+void CheckLockPriorityInversion(const void* lock, TaskHandle_t holder, UBaseType_t holderPriority)
+{
+  const LockWatchdogCallback callback = watchdogCallback.load(std::memory_order_acquire);
+
+  if ((nullptr == callback) || (nullptr == holder))
+  {
+    return;
+  }
+
+  // The holder may release the lock and be deleted at any time, so its handle is not passed to the kernel.
+  const TaskHandle_t waiter = xTaskGetCurrentTaskHandle();
+  const UBaseType_t waiterPriority = uxTaskPriorityGet(nullptr);
+
+  if (holderPriority < waiterPriority)
+  {
+    callback(LockWatchdogEvent{LockWatchdogEventType::PriorityInversion, lock, holder, holderPriority, waiter, waiterPriority, 0});
+  }
+}
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
@@ -3,32 +3,101 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
-#include <cstdint>
+// Shared by the FreeRTOS and the host backend, see NativeMutex.hpp.
 
-#include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
+#include <cassert>
+#include <cstdint>
 
 #include <kernelapi/rtos/Ticks.hpp>
 #include <kernelapi/rtos/Mutex.hpp>
 
+#include "NativeMutex.hpp"
+
 namespace rtos
 {
 
 Mutex::Mutex() :
-  _handle{nullptr}
+  Mutex(0)
+{
+}
+
+Mutex::Mutex(uint32_t maxSpinCount) :
+  _handle{nullptr},
+  _lazy{false},
+  _createFailed{false},
+  _maxSpinCount{maxSpinCount}
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  , _lockStats{this}
+#endif
+{
+  _handle.store(detail::CreateNativeMutex(false), std::memory_order_relaxed);
+  assert(IsCreated() && "Failed to create the mutex");
+}
+
+Mutex::Mutex(LazyCreate, uint32_t maxSpinCount) :
+  _handle{nullptr},
+  _lazy{true},
+  _createFailed{false},
+  _maxSpinCount{maxSpinCount}
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  , _lockStats{this}
+#endif
 {
-  _handle = xSemaphoreCreateMutex();
-  assert(_handle && "Failed to create the mutex");
 }
 
 Mutex::~Mutex()
 {
-  vSemaphoreDelete(_handle);
+  if (IsCreated())
+  {
+    detail::DeleteNativeMutex(_handle.load(std::memory_order_acquire));
+  }
 }
 
 bool Mutex::IsValid() const
 {
-  return (nullptr != _handle);
+  return (_lazy && !_createFailed.load(std::memory_order_acquire)) || IsCreated();
+}
+
+bool Mutex::IsCreated() const
+{
+  return (nullptr != _handle.load(std::memory_order_acquire));
+}
+
+Mutex::NativeHdl Mutex::GetHandle()
+{
+  NativeHdl handle = _handle.load(std::memory_order_acquire);
+  if ((nullptr != handle) || !_lazy || _createFailed.load(std::memory_order_acquire))
+  {
+    return handle;
+  }
+
+  // Several tasks may create a native mutex concurrently, only the first one is kept.
+  NativeHdl created = detail::CreateNativeMutex(false);
+
+  // Remember the failure, so IsValid() reports it and Lock() does not wait forever.
+  if (nullptr == created)
+  {
+    _createFailed.store(true, std::memory_order_release);
+    return _handle.load(std::memory_order_acquire);
+  }
+
+  if (!_handle.compare_exchange_strong(handle, created, std::memory_order_acq_rel, std::memory_order_acquire))
+  {
+    detail::DeleteNativeMutex(created);
+    return handle;
+  }
+
+  return created;
+}
+
+void Mutex::SetMaxSpinCount(uint32_t maxSpinCount)
+{
+  _maxSpinCount = maxSpinCount;
+}
+
+uint32_t Mutex::GetMaxSpinCount() const
+{
+  return _maxSpinCount;
 }
 
 bool Mutex::TryLock()
@@ -38,8 +107,61 @@ bool Mutex::TryLock()
 
 bool Mutex::TryLockFor(rtos::Ticks_t timeout)
 {
-  const BaseType_t ret = xSemaphoreTake(static_cast<QueueHandle_t>(_handle), timeout);
-  return (pdTRUE == ret);
+  // Creates the native mutex on first use, if its creation was deferred.
+  const NativeHdl handle = GetHandle();
+  if (nullptr == handle)
+  {
+    return false;
+  }
+
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  const uint32_t startTime = GetLockStatsTimestamp();
+
+  // A failing non-blocking take identifies a contended acquisition.
+  if (detail::TakeNativeMutex(handle, false, 0))
+  {
+    _lockStats.OnAcquired(startTime, false);
+    return true;
+  }
+
+  if (0 == timeout)
+  {
+    return false;
+  }
+
+  _lockStats.OnContended(detail::GetNativeMutexHolder(handle));
+  const bool locked = Take(timeout);
+  if (locked)
+  {
+    _lockStats.OnAcquired(startTime, true);
+  }
+
+  return locked;
+#else
+  return Take(timeout);
+#endif
+}
+
+bool Mutex::Take(rtos::Ticks_t timeout)
+{
+  rtos::Ticks_t remaining {timeout};
+
+  // Spinning is only useful, when the caller is willing to wait.
+  if ((0 != timeout) && (0 != _maxSpinCount))
+  {
+    detail::NativeTimeOut timeOutState;
+    detail::SetNativeTimeOut(timeOutState);
+
+    if (TrySpinLock())
+    {
+      return true;
+    }
+
+    // The spin phase is part of the timeout, an infinite timeout is kept.
+    detail::CheckNativeTimeOut(timeOutState, remaining);
+  }
+
+  return detail::TakeNativeMutex(_handle.load(std::memory_order_acquire), false, remaining);
 }
 
 void Mutex::Lock()
@@ -51,20 +173,57 @@ void Mutex::Lock()
   do
   {
     locked = TryLockFor(GetMaxDelay());
+
+    // Waiting is pointless, if the native mutex could not be created.
+    if (!locked && !IsCreated())
+    {
+      assert(false && "Failed to create the mutex");
+      return;
+    }
   }
   while(!locked);
 }
 
 void Mutex::Unlock()
 {
-  [[maybe_unused]] const BaseType_t ret = xSemaphoreGive(static_cast<QueueHandle_t>(_handle));
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  _lockStats.OnReleased();
+#endif
+  detail::GiveNativeMutex(_handle.load(std::memory_order_acquire), false);
+}
+
+bool Mutex::TrySpinLock()
+{
+  const NativeHdl handle = _handle.load(std::memory_order_acquire);
+
+  for (uint32_t spinCount = 0; spinCount < _maxSpinCount; ++spinCount)
+  {
+    if (detail::TakeNativeMutex(handle, false, 0))
+    {
+      return true;
+    }
+
+    // Spinning is pointless if we are the holder. The state of the holder is not queried, it may be deleted meanwhile
+    // and its handle is only compared.
+    if (detail::GetNativeTask() == detail::GetNativeMutexHolder(handle))
+    {
+      return false;
+    }
+  }
+
+  return false;
 }
 
 bool Mutex::IsLocked()
 {
-  // If not locked, xSemaphoreGetMutexHolder returns NULL
-  const TaskHandle_t taskHdl = xSemaphoreGetMutexHolder(static_cast<QueueHandle_t>(_handle));
-  return (nullptr != taskHdl);
+  const NativeHdl handle = _handle.load(std::memory_order_acquire);
+  if (nullptr == handle)
+  {
+    return false;
+  }
+
+  // If not locked, the native mutex has no holder.
+  return (nullptr != detail::GetNativeMutexHolder(handle));
 }
 
 } // namespace rtos
@@ -0,0 +1,173 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_B9B4FD569015442D8D7F87034B03B0AA
+#define HEADER_B9B4FD569015442D8D7F87034B03B0AA
+
+#include <kernelapi/rtos/Ticks.hpp>
+
+#if defined(KERNELAPI_BACKEND_HOST)
+  #include <chrono>
+  #include <new>
+
+  #include "host/HostMutex.hpp"
+#else
+  #include <freertos/FreeRTOS.h>
+  #include <freertos/semphr.h>
+  #include <freertos/task.h>
+#endif
+
+namespace rtos
+{
+
+namespace detail
+{
+
+// The native mutex of the backend, which Mutex and RecursiveMutex are built on: A FreeRTOS mutex or a HostMutex.
+// The lazy creation, the validity, the Lock() loop, the spin phase and the cached owner are implemented once by the lock classes,
+// the backends only provide these few functions.
+
+using NativeMutexHdl = void*;
+
+#if defined(KERNELAPI_BACKEND_HOST)
+// The host backend, see the FreeRTOS backend below for the documentation of the functions.
+
+using NativeTimeOut = std::chrono::steady_clock::time_point;
+
+inline NativeMutexHdl CreateNativeMutex(bool recursive)
+{
+  return new (std::nothrow) HostMutex{recursive};
+}
+
+inline void DeleteNativeMutex(NativeMutexHdl handle)
+{
+  delete static_cast<HostMutex*>(handle);
+}
+
+inline bool TakeNativeMutex(NativeMutexHdl handle, bool, rtos::Ticks_t timeout)
+{
+  HostMutex& hostMutex = *static_cast<HostMutex*>(handle);
+  if (GetMaxDelay() == timeout)
+  {
+    hostMutex.Lock();
+    return true;
+  }
+
+  return hostMutex.TryLockFor(rtos::TickDuration{timeout});
+}
+
+inline void GiveNativeMutex(NativeMutexHdl handle, bool)
+{
+  static_cast<HostMutex*>(handle)->Unlock();
+}
+
+inline void* GetNativeMutexHolder(NativeMutexHdl handle)
+{
+  return static_cast<HostMutex*>(handle)->GetOwner();
+}
+
+inline void* GetNativeTask()
+{
+  return GetHostThreadTag();
+}
+
+inline void SetNativeTimeOut(NativeTimeOut& timeOut)
+{
+  timeOut = std::chrono::steady_clock::now();
+}
+
+inline void CheckNativeTimeOut(const NativeTimeOut& timeOut, rtos::Ticks_t& remaining)
+{
+  if (GetMaxDelay() == remaining)
+  {
+    return;
+  }
+
+  const auto elapsed = std::chrono::duration_cast<rtos::TickDuration>(std::chrono::steady_clock::now() - timeOut).count();
+  remaining = (elapsed < remaining) ? static_cast<rtos::Ticks_t>(remaining - elapsed) : 0;
+}
+#else
+using NativeTimeOut = TimeOut_t;
+
+/**
+ * @brief Creates a native mutex.
+ * @param[in] recursive true for a recursive mutex.
+ * @returns the handle of the native mutex, nullptr if out of memory.
+ */
+inline NativeMutexHdl CreateNativeMutex(bool recursive)
+{
+  return recursive ? xSemaphoreCreateRecursiveMutex() : xSemaphoreCreateMutex();
+}
+
+/**
+ * @brief Deletes the native mutex.
+ */
+inline void DeleteNativeMutex(NativeMutexHdl handle)
+{
+  vSemaphoreDelete(handle);
+}
+
+/**
+ * @brief Takes the native mutex.
+ * @param[in] recursive true if it was created as recursive mutex.
+ * @param[in] timeout maximum time to block until.
+ * @returns true, if it owns the lock, false otherwise.
+ */
+inline bool TakeNativeMutex(NativeMutexHdl handle, bool recursive, rtos::Ticks_t timeout)
+{
+  const QueueHandle_t queue = static_cast<QueueHandle_t>(handle);
+  return (pdTRUE == (recursive ? xSemaphoreTakeRecursive(queue, timeout) : xSemaphoreTake(queue, timeout)));
+}
+
+/**
+ * @brief Gives the native mutex, must be called by the holder.
+ * @param[in] recursive true if it was created as recursive mutex.
+ */
+inline void GiveNativeMutex(NativeMutexHdl handle, bool recursive)
+{
+  const QueueHandle_t queue = static_cast<QueueHandle_t>(handle);
+  [[maybe_unused]] const BaseType_t ret = recursive ? xSemaphoreGiveRecursive(queue) : xSemaphoreGive(queue);
+}
+
+/**
+ * @returns the task holding the native mutex, nullptr if not locked. It may be deleted at any time, only compare it.
+ */
+inline void* GetNativeMutexHolder(NativeMutexHdl handle)
+{
+  return xSemaphoreGetMutexHolder(static_cast<QueueHandle_t>(handle));
+}
+
+/**
+ * @returns the calling task, as returned by GetNativeMutexHolder().
+ */
+inline void* GetNativeTask()
+{
+  return xTaskGetCurrentTaskHandle();
+}
+
+/**
+ * @brief Captures the current time, to be passed to CheckNativeTimeOut().
+ */
+inline void SetNativeTimeOut(NativeTimeOut& timeOut)
+{
+  vTaskSetTimeOutState(&timeOut);
+}
+
+/**
+ * @brief Subtracts the time elapsed since SetNativeTimeOut() from \a remaining, an infinite timeout is kept.
+ */
+inline void CheckNativeTimeOut(NativeTimeOut& timeOut, rtos::Ticks_t& remaining)
+{
+  TickType_t ticks {remaining};
+  (void)xTaskCheckForTimeOut(&timeOut, &ticks);
+  remaining = ticks;
+}
+#endif
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_B9B4FD569015442D8D7F87034B03B0AA
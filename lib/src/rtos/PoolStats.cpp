@@ -0,0 +1,115 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+
+#include <kernelapi/rtos/PoolStats.hpp>
+#include <kernelapi/rtos/StatsRegistry.hpp>
+
+namespace rtos
+{
+
+namespace
+{
+
+// The global list of pool statistics.
+detail::StatsRegistry<PoolStatsRecord, PoolStats> registry {};
+
+} // namespace
+
+PoolStatsRecord::PoolStatsRecord(const void* pool, uint32_t capacity) :
+  _pool{pool},
+  _capacity{capacity},
+  _allocations{0},
+  _exhaustions{0},
+  _inUse{0},
+  _maxInUse{0},
+  _next{nullptr}
+{
+  registry.Register(*this);
+}
+
+PoolStatsRecord::~PoolStatsRecord()
+{
+  registry.Unregister(*this);
+}
+
+void PoolStatsRecord::OnAllocated()
+{
+  _allocations.fetch_add(1, std::memory_order_relaxed);
+  const uint32_t inUse = _inUse.fetch_add(1, std::memory_order_relaxed) + 1;
+
+  uint32_t maxInUse = _maxInUse.load(std::memory_order_relaxed);
+  while ((inUse > maxInUse) && !_maxInUse.compare_exchange_weak(maxInUse, inUse, std::memory_order_relaxed))
+  {
+  }
+}
+
+void PoolStatsRecord::OnExhausted()
+{
+  _exhaustions.fetch_add(1, std::memory_order_relaxed);
+}
+
+void PoolStatsRecord::OnFreed()
+{
+  _inUse.fetch_sub(1, std::memory_order_relaxed);
+}
+
+PoolStats PoolStatsRecord::GetStats() const
+{
+  return PoolStats{_pool, _capacity,
+                   _allocations.load(std::memory_order_relaxed), _exhaustions.load(std::memory_order_relaxed),
+                   _inUse.load(std::memory_order_relaxed), _maxInUse.load(std::memory_order_relaxed)};
+}
+
+void PoolStatsRecord::Reset()
+{
+  _allocations.store(0, std::memory_order_relaxed);
+  _exhaustions.store(0, std::memory_order_relaxed);
+  _maxInUse.store(_inUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+uint32_t GetPoolStats(PoolStats* buffer, uint32_t count, uint32_t first)
+{
+  return registry.Copy(buffer, count, first);
+}
+
+void ResetPoolStats()
+{
+  registry.Reset();
+}
+
+void PrintPoolStats()
+{
+  // Copy a few records at once, so the registry is locked only briefly and not while printing.
+  constexpr uint32_t bufferSize {8};
+  PoolStats buffer[bufferSize];
+  uint32_t first {0};
+  uint32_t copied {0};
+
+  printf("pool,capacity,allocations,exhaustions,in_use,max_in_use\n");
+
+  do
+  {
+    copied = GetPoolStats(buffer, bufferSize, first);
+    for (uint32_t i = 0; i < copied; ++i)
+    {
+      const PoolStats& stats = buffer[i];
+      printf("%p,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32 "\n",
+             stats.pool, stats.capacity, stats.allocations, stats.exhaustions, stats.inUse, stats.maxInUse);
+    }
+    first += copied;
+  }
+  while (bufferSize == copied);
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
@@ -3,32 +3,100 @@
 // This software is released under the MIT License.
 // https://opensource.org/licenses/MIT
 
-#include <cstdint>
+// Shared by the FreeRTOS and the host backend, see NativeMutex.hpp.
 
-#include <freertos/FreeRTOS.h>
-#include <freertos/semphr.h>
+#include <cassert>
+#include <cstdint>
 
 #include <kernelapi/rtos/Ticks.hpp>
 #include <kernelapi/rtos/RecursiveMutex.hpp>
 
+#include "NativeMutex.hpp"
+
 namespace rtos
 {
 
 RecursiveMutex::RecursiveMutex() :
-  _handle{nullptr}
+  RecursiveMutex(Recursion::Native)
+{
+}
+
+RecursiveMutex::RecursiveMutex(Recursion recursion) :
+  _handle{nullptr},
+  _lazy{false},
+  _createFailed{false},
+  _recursion{recursion},
+  _owner{nullptr},
+  _depth{0}
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  , _lockStats{this}
+#endif
+{
+  _handle.store(detail::CreateNativeMutex(true), std::memory_order_relaxed);
+  assert(IsCreated() && "Failed to create the recursive mutex");
+}
+
+RecursiveMutex::RecursiveMutex(LazyCreate, Recursion recursion) :
+  _handle{nullptr},
+  _lazy{true},
+  _createFailed{false},
+  _recursion{recursion},
+  _owner{nullptr},
+  _depth{0}
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  , _lockStats{this}
+#endif
 {
-  _handle = xSemaphoreCreateRecursiveMutex();
-  assert(_handle && "Failed to create the recursive mutex");
 }
 
 RecursiveMutex::~RecursiveMutex()
 {
-  vSemaphoreDelete(_handle);
+  if (IsCreated())
+  {
+    detail::DeleteNativeMutex(_handle.load(std::memory_order_acquire));
+  }
 }
 
 bool RecursiveMutex::IsValid() const
 {
-  return (nullptr != _handle);
+  return (_lazy && !_createFailed.load(std::memory_order_acquire)) || IsCreated();
+}
+
+bool RecursiveMutex::IsCreated() const
+{
+  return (nullptr != _handle.load(std::memory_order_acquire));
+}
+
+RecursiveMutex::NativeHdl RecursiveMutex::GetHandle()
+{
+  NativeHdl handle = _handle.load(std::memory_order_acquire);
+  if ((nullptr != handle) || !_lazy || _createFailed.load(std::memory_order_acquire))
+  {
+    return handle;
+  }
+
+  // Several tasks may create a native mutex concurrently, only the first one is kept.
+  NativeHdl created = detail::CreateNativeMutex(true);
+
+  // Remember the failure, so IsValid() reports it and Lock() does not wait forever.
+  if (nullptr == created)
+  {
+    _createFailed.store(true, std::memory_order_release);
+    return _handle.load(std::memory_order_acquire);
+  }
+
+  if (!_handle.compare_exchange_strong(handle, created, std::memory_order_acq_rel, std::memory_order_acquire))
+  {
+    detail::DeleteNativeMutex(created);
+    return handle;
+  }
+
+  return created;
+}
+
+RecursiveMutex::Recursion RecursiveMutex::GetRecursion() const
+{
+  return _recursion;
 }
 
 bool RecursiveMutex::TryLock()
@@ -38,8 +106,82 @@ bool RecursiveMutex::TryLock()
 
 bool RecursiveMutex::TryLockFor(rtos::Ticks_t timeout)
 {
-  const BaseType_t ret = xSemaphoreTakeRecursive(static_cast<QueueHandle_t>(_handle), timeout);
-  return (pdTRUE == ret);
+  // Creates the native mutex on first use, if its creation was deferred.
+  const NativeHdl handle = GetHandle();
+  if (nullptr == handle)
+  {
+    return false;
+  }
+
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  const uint32_t startTime = GetLockStatsTimestamp();
+
+  // A failing non-blocking take identifies a contended acquisition.
+  if (Take(0))
+  {
+    _lockStats.OnAcquired(startTime, false);
+    return true;
+  }
+
+  if (0 == timeout)
+  {
+    return false;
+  }
+
+  _lockStats.OnContended(detail::GetNativeMutexHolder(handle));
+  const bool locked = Take(timeout);
+  if (locked)
+  {
+    _lockStats.OnAcquired(startTime, true);
+  }
+
+  return locked;
+#else
+  return Take(timeout);
+#endif
+}
+
+bool RecursiveMutex::Take(rtos::Ticks_t timeout)
+{
+  const NativeHdl handle = _handle.load(std::memory_order_acquire);
+
+  if (Recursion::Native == _recursion)
+  {
+    return detail::TakeNativeMutex(handle, true, timeout);
+  }
+
+  // Only the owner task itself stores its handle, so a stale value read by another task never matches.
+  void* const self = detail::GetNativeTask();
+  if (self == _owner.load(std::memory_order_relaxed))
+  {
+    ++_depth;
+    return true;
+  }
+
+  if (!detail::TakeNativeMutex(handle, true, timeout))
+  {
+    return false;
+  }
+
+  _owner.store(self, std::memory_order_relaxed);
+  _depth = 1;
+  return true;
+}
+
+void RecursiveMutex::Give()
+{
+  if (Recursion::OwnerCached == _recursion)
+  {
+    assert((detail::GetNativeTask() == _owner.load(std::memory_order_relaxed)) && "The mutex is not owned by the calling task");
+    if (0 != --_depth)
+    {
+      return;
+    }
+
+    _owner.store(nullptr, std::memory_order_relaxed);
+  }
+
+  detail::GiveNativeMutex(_handle.load(std::memory_order_acquire), true);
 }
 
 void RecursiveMutex::Lock()
@@ -51,20 +193,35 @@ void RecursiveMutex::Lock()
   do
   {
     locked = TryLockFor(GetMaxDelay());
+
+    // Waiting is pointless, if the native mutex could not be created.
+    if (!locked && !IsCreated())
+    {
+      assert(false && "Failed to create the recursive mutex");
+      return;
+    }
   }
   while(!locked);
 }
 
 void RecursiveMutex::Unlock()
 {
-  [[maybe_unused]] const BaseType_t ret = xSemaphoreGiveRecursive(static_cast<QueueHandle_t>(_handle));
+#if defined(KERNELAPI_ENABLE_LOCK_STATS)
+  _lockStats.OnReleased();
+#endif
+  Give();
 }
 
 bool RecursiveMutex::IsLocked()
 {
-  // If not locked, xSemaphoreGetMutexHolder returns NULL
-  const TaskHandle_t taskHdl = xSemaphoreGetMutexHolder(static_cast<QueueHandle_t>(_handle));
-  return (nullptr != taskHdl);
+  const NativeHdl handle = _handle.load(std::memory_order_acquire);
+  if (nullptr == handle)
+  {
+    return false;
+  }
+
+  // If not locked, the native mutex has no holder.
+  return (nullptr != detail::GetNativeMutexHolder(handle));
 }
 
 } // namespace rtos
@@ -0,0 +1,152 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/SharedMutex.hpp>
+
+namespace rtos
+{
+
+SharedMutex::SharedMutex(uint32_t maxReaders, Preference preference) :
+  _writerMutex{},
+  _tokens{nullptr},
+  _maxReaders{maxReaders},
+  _preference{preference}
+{
+  assert((0 < _maxReaders) && "The shared mutex needs at least one reader token");
+  _tokens = xSemaphoreCreateCounting(_maxReaders, _maxReaders);
+  assert(_tokens && "Failed to create the shared mutex");
+}
+
+SharedMutex::~SharedMutex()
+{
+  vSemaphoreDelete(_tokens);
+}
+
+bool SharedMutex::IsValid() const
+{
+  return (nullptr != _tokens) && _writerMutex.IsValid();
+}
+
+void SharedMutex::Lock()
+{
+  bool locked {false};
+
+  // Wait until we got the lock.
+  // Use while loop in case infinite wait is not implemented by the rtos port.
+  do
+  {
+    locked = TryLockFor(GetMaxDelay());
+  }
+  while(!locked);
+}
+
+bool SharedMutex::TryLock()
+{
+  return TryLockFor(0);
+}
+
+bool SharedMutex::TryLockFor(rtos::Ticks_t timeout)
+{
+  TimeOut_t timeOutState;
+  TickType_t remaining {timeout};
+  vTaskSetTimeOutState(&timeOutState);
+
+  // The writer mutex is kept until Unlock(), so no other writer competes for the tokens.
+  if (!_writerMutex.TryLockFor(remaining))
+  {
+    return false;
+  }
+
+  // Owning all tokens means that no reader owns the lock.
+  for (uint32_t taken = 0; taken < _maxReaders; ++taken)
+  {
+    // Updates the remaining time, it is set to zero when the timeout has been reached.
+    (void)xTaskCheckForTimeOut(&timeOutState, &remaining);
+
+    if (pdTRUE != xSemaphoreTake(static_cast<QueueHandle_t>(_tokens), remaining))
+    {
+      GiveTokens(taken);
+      _writerMutex.Unlock();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void SharedMutex::Unlock()
+{
+  GiveTokens(_maxReaders);
+  _writerMutex.Unlock();
+}
+
+void SharedMutex::LockShared()
+{
+  bool locked {false};
+
+  // Wait until we got the lock.
+  // Use while loop in case infinite wait is not implemented by the rtos port.
+  do
+  {
+    locked = TryLockSharedFor(GetMaxDelay());
+  }
+  while(!locked);
+}
+
+bool SharedMutex::TryLockShared()
+{
+  return TryLockSharedFor(0);
+}
+
+bool SharedMutex::TryLockSharedFor(rtos::Ticks_t timeout)
+{
+  if (Preference::Readers == _preference)
+  {
+    return (pdTRUE == xSemaphoreTake(static_cast<QueueHandle_t>(_tokens), timeout));
+  }
+
+  TimeOut_t timeOutState;
+  TickType_t remaining {timeout};
+  vTaskSetTimeOutState(&timeOutState);
+
+  // Pass the writer mutex, so readers queue up behind a waiting writer.
+  if (!_writerMutex.TryLockFor(remaining))
+  {
+    return false;
+  }
+
+  (void)xTaskCheckForTimeOut(&timeOutState, &remaining);
+  const BaseType_t ret = xSemaphoreTake(static_cast<QueueHandle_t>(_tokens), remaining);
+  _writerMutex.Unlock();
+
+  return (pdTRUE == ret);
+}
+
+void SharedMutex::UnlockShared()
+{
+  GiveTokens(1);
+}
+
+void SharedMutex::GiveTokens(uint32_t count)
+{
+  for (uint32_t given = 0; given < count; ++given)
+  {
+    [[maybe_unused]] const BaseType_t ret = xSemaphoreGive(static_cast<QueueHandle_t>(_tokens));
+  }
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/StaticMutex.hpp>
+
+namespace rtos
+{
+
+StaticMutex::StaticMutex() :
+  _storage{},
+  _handle{nullptr}
+{
+  // Does not fail, when a valid storage buffer is given.
+  _handle = xSemaphoreCreateMutexStatic(&_storage);
+  assert(_handle && "Failed to create the static mutex");
+}
+
+StaticMutex::~StaticMutex()
+{
+  // No memory is freed for static mutexes, but the kernel unregisters the mutex.
+  vSemaphoreDelete(_handle);
+}
+
+bool StaticMutex::IsValid() const
+{
+  return (nullptr != _handle);
+}
+
+bool StaticMutex::TryLock()
+{
+  return TryLockFor(0);
+}
+
+bool StaticMutex::TryLockFor(rtos::Ticks_t timeout)
+{
+  const BaseType_t ret = xSemaphoreTake(_handle, timeout);
+  return (pdTRUE == ret);
+}
+
+void StaticMutex::Lock()
+{
+  bool locked {false};
+
+  // Wait until we got the lock.
+  // Use while loop in case infinite wait is not implemented by the rtos port.
+  do
+  {
+    locked = TryLockFor(GetMaxDelay());
+  }
+  while(!locked);
+}
+
+void StaticMutex::Unlock()
+{
+  [[maybe_unused]] const BaseType_t ret = xSemaphoreGive(_handle);
+}
+
+bool StaticMutex::IsLocked()
+{
+  // If not locked, xSemaphoreGetMutexHolder returns NULL
+  const TaskHandle_t taskHdl = xSemaphoreGetMutexHolder(_handle);
+  return (nullptr != taskHdl);
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
@@ -0,0 +1,78 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/StaticRecursiveMutex.hpp>
+
+namespace rtos
+{
+
+StaticRecursiveMutex::StaticRecursiveMutex() :
+  _storage{},
+  _handle{nullptr}
+{
+  // Does not fail, when a valid storage buffer is given.
+  _handle = xSemaphoreCreateRecursiveMutexStatic(&_storage);
+  assert(_handle && "Failed to create the static recursive mutex");
+}
+
+StaticRecursiveMutex::~StaticRecursiveMutex()
+{
+  // No memory is freed for static mutexes, but the kernel unregisters the mutex.
+  vSemaphoreDelete(_handle);
+}
+
+bool StaticRecursiveMutex::IsValid() const
+{
+  return (nullptr != _handle);
+}
+
+bool StaticRecursiveMutex::TryLock()
+{
+  return TryLockFor(0);
+}
+
+bool StaticRecursiveMutex::TryLockFor(rtos::Ticks_t timeout)
+{
+  const BaseType_t ret = xSemaphoreTakeRecursive(_handle, timeout);
+  return (pdTRUE == ret);
+}
+
+void StaticRecursiveMutex::Lock()
+{
+  bool locked {false};
+
+  // Wait until we got the lock.
+  // Use while loop in case infinite wait is not implemented by the rtos port.
+  do
+  {
+    locked = TryLockFor(GetMaxDelay());
+  }
+  while(!locked);
+}
+
+void StaticRecursiveMutex::Unlock()
+{
+  [[maybe_unused]] const BaseType_t ret = xSemaphoreGiveRecursive(_handle);
+}
+
+bool StaticRecursiveMutex::IsLocked()
+{
+  // If not locked, xSemaphoreGetMutexHolder returns NULL
+  const TaskHandle_t taskHdl = xSemaphoreGetMutexHolder(_handle);
+  return (nullptr != taskHdl);
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
@@ -0,0 +1,152 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Not available in the host backend.
+#if !defined(KERNELAPI_BACKEND_HOST)
+
+#include <cassert>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <freertos/timers.h>
+
+#include <kernelapi/rtos/Isr.hpp>
+#include <kernelapi/rtos/Ticks.hpp>
+#include <kernelapi/rtos/Timer.hpp>
+
+namespace rtos
+{
+
+namespace
+{
+
+// Runs within the timer service task after all commands sent before, releases the task destroying the Timer.
+void OnCommandsProcessed(void* processed, uint32_t)
+{
+  xSemaphoreGive(static_cast<SemaphoreHandle_t>(processed));
+}
+
+} // namespace
+
+Timer::Timer(const char* name, rtos::Ticks_t period, bool autoReload, const Callback& callback) :
+  _callback{callback},
+  _storage{},
+  _handle{nullptr}
+{
+  assert((0 < period) && "The period of a timer must be greater than 0");
+
+  // Does not fail, when a valid storage buffer is given. The timer ID refers to this instance.
+  _handle = xTimerCreateStatic(name, period, autoReload ? pdTRUE : pdFALSE, this, &Timer::OnExpired, &_storage);
+  assert(_handle && "Failed to create the timer");
+}
+
+Timer::~Timer()
+{
+  // Within the timer service task the commands are processed after the caller returns, the storage is gone by then.
+  // Waiting for them would never return, so send them without blocking.
+  if (xTimerGetTimerDaemonTaskHandle() == xTaskGetCurrentTaskHandle())
+  {
+    assert(false && "A Timer must not be destroyed within the timer service task");
+    (void)xTimerStop(_handle, 0);
+    (void)xTimerDelete(_handle, 0);
+    return;
+  }
+
+  // Use while loops in case infinite wait is not implemented by the rtos port.
+  while (pdPASS != xTimerStop(_handle, GetMaxDelay()))
+  {
+  }
+  while (pdPASS != xTimerDelete(_handle, GetMaxDelay()))
+  {
+  }
+
+  // No memory is freed for static timers, but the timer service task still refers to the storage until it has processed
+  // the commands. It processes them in order: Once the pended call runs, the timer is deleted and the callback is not running.
+  StaticSemaphore_t processedStorage;
+  const SemaphoreHandle_t processed = xSemaphoreCreateBinaryStatic(&processedStorage);
+  while (pdPASS != xTimerPendFunctionCall(&OnCommandsProcessed, processed, 0, GetMaxDelay()))
+  {
+  }
+  while (pdTRUE != xSemaphoreTake(processed, GetMaxDelay()))
+  {
+  }
+  vSemaphoreDelete(processed);
+}
+
+bool Timer::IsValid() const
+{
+  return (nullptr != _handle);
+}
+
+bool Timer::Start(rtos::Ticks_t timeout)
+{
+  return (pdPASS == xTimerStart(_handle, timeout));
+}
+
+bool Timer::Stop(rtos::Ticks_t timeout)
+{
+  return (pdPASS == xTimerStop(_handle, timeout));
+}
+
+bool Timer::Reset(rtos::Ticks_t timeout)
+{
+  return (pdPASS == xTimerReset(_handle, timeout));
+}
+
+bool Timer::ChangePeriod(rtos::Ticks_t period, rtos::Ticks_t timeout)
+{
+  assert((0 < period) && "The period of a timer must be greater than 0");
+  return (pdPASS == xTimerChangePeriod(_handle, period, timeout));
+}
+
+bool Timer::StartFromISR(BaseType_t* higherPriorityTaskWoken)
+{
+  BaseType_t woken {pdFALSE};
+  const BaseType_t ret = xTimerStartFromISR(_handle, &woken);
+  detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  return (pdPASS == ret);
+}
+
+bool Timer::StopFromISR(BaseType_t* higherPriorityTaskWoken)
+{
+  BaseType_t woken {pdFALSE};
+  const BaseType_t ret = xTimerStopFromISR(_handle, &woken);
+  detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  return (pdPASS == ret);
+}
+
+bool Timer::ResetFromISR(BaseType_t* higherPriorityTaskWoken)
+{
+  BaseType_t woken {pdFALSE};
+  const BaseType_t ret = xTimerResetFromISR(_handle, &woken);
+  detail::YieldFromISR(woken, higherPriorityTaskWoken);
+  return (pdPASS == ret);
+}
+
+bool Timer::IsActive() const
+{
+  return (pdFALSE != xTimerIsTimerActive(_handle));
+}
+
+rtos::Ticks_t Timer::GetPeriod() const
+{
+  return xTimerGetPeriod(_handle);
+}
+
+TickType_t Timer::GetExpiryTime() const
+{
+  return xTimerGetExpiryTime(_handle);
+}
+
+void Timer::OnExpired(TimerHandle_t handle)
+{
+  Timer& timer = *static_cast<Timer*>(pvTimerGetTimerID(handle));
+  timer._callback();
+}
+
+} // namespace rtos
+
+#endif // !defined(KERNELAPI_BACKEND_HOST)
@@ -0,0 +1,154 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_8295312A6F9E4367B012BD933E249B9A
+#define HEADER_8295312A6F9E4367B012BD933E249B9A
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace rtos
+{
+
+namespace detail
+{
+
+/**
+ * @returns a tag unique to the calling thread, the host counterpart of the handle of the calling task.
+ */
+inline void* GetHostThreadTag()
+{
+  static thread_local char tag {0};
+  return &tag;
+}
+
+/**
+ * @brief The HostMutex class is the native mutex of the host backend, see NativeMutex.hpp.
+ *        It is built on std::mutex and std::condition_variable instead of std::timed_mutex:
+ *        The ThreadSanitizer of GCC 12 does not intercept the timed lock of std::timed_mutex and reports false data races
+ *        and unlocks of unlocked mutexes, whereas it fully understands condition variables.
+ */
+class HostMutex
+{
+  // Make this class non-copyable
+  public:
+  HostMutex(const HostMutex& other) = delete;
+  HostMutex& operator=(const HostMutex& other) = delete;
+
+  public:
+  /**
+   * The constructor.
+   * @param[in] recursive If true, the owner thread can lock the mutex again, otherwise it blocks like any other thread.
+   */
+  explicit HostMutex(bool recursive) :
+    _recursive{recursive}
+  {}
+
+  public:
+  /**
+   * @brief Locks the mutex, blocks until it is available.
+   */
+  void Lock()
+  {
+    std::unique_lock<std::mutex> lock {_mutex};
+    if (!TakeRecursive())
+    {
+      _released.wait(lock, [this]() { return (0 == _depth); });
+      Take();
+    }
+  }
+
+  /**
+   * @brief Tries to lock the mutex, does not block.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  bool TryLock()
+  {
+    return TryLockFor(std::chrono::nanoseconds{0});
+  }
+
+  /**
+   * @brief Tries to lock the mutex, blocks until the timeout has been reached.
+   * @param[in] timeout maximum duration to block until, a negative duration does not block.
+   * @returns true if it owns the lock, false otherwise.
+   */
+  template <typename REP, typename PERIOD>
+  bool TryLockFor(const std::chrono::duration<REP, PERIOD>& timeout)
+  {
+    std::unique_lock<std::mutex> lock {_mutex};
+    if (TakeRecursive())
+    {
+      return true;
+    }
+
+    if (!_released.wait_for(lock, timeout, [this]() { return (0 == _depth); }))
+    {
+      return false;
+    }
+
+    Take();
+    return true;
+  }
+
+  /**
+   * @brief Unlocks the mutex, a recursive mutex is released by the last Unlock().
+   */
+  void Unlock()
+  {
+    {
+      std::lock_guard<std::mutex> lock {_mutex};
+      if (0 != --_depth)
+      {
+        return;
+      }
+    }
+
+    _released.notify_one();
+  }
+
+  /**
+   * @returns the tag of the thread owning the mutex, nullptr if not locked.
+   */
+  void* GetOwner() const
+  {
+    std::lock_guard<std::mutex> lock {_mutex};
+    return (0 != _depth) ? _owner : nullptr;
+  }
+
+  private:
+  // Locks the mutex again, if it is recursive and owned by the calling thread. Called with _mutex locked.
+  bool TakeRecursive()
+  {
+    if (_recursive && (0 != _depth) && (GetHostThreadTag() == _owner))
+    {
+      ++_depth;
+      return true;
+    }
+
+    return false;
+  }
+
+  // Takes the released mutex. Called with _mutex locked.
+  void Take()
+  {
+    _owner = GetHostThreadTag();
+    _depth = 1;
+  }
+
+  private:
+  const bool _recursive;                /** true if the owner thread can lock the mutex again. */
+  mutable std::mutex _mutex;            /** Protects the state of the mutex. */
+  std::condition_variable _released;    /** Notified when the mutex is released. */
+  void* _owner {nullptr};               /** The tag of the thread owning the mutex. */
+  uint32_t _depth {0};                  /** The recursion depth, 0 if the mutex is not locked. */
+};
+
+} // namespace detail
+
+} // namespace rtos
+
+#endif // HEADER_8295312A6F9E4367B012BD933E249B9A
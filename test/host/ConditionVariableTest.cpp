@@ -0,0 +1,154 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/ConditionVariable.hpp>
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/UniqueLock.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Waits until the task blocks in the kernel, e.g. for its notification.
+void WaitUntilBlocked(const std::atomic<TaskHandle_t>& task)
+{
+  while ((nullptr == task.load()) || (eBlocked != eTaskGetState(task.load())))
+  {
+    std::this_thread::yield();
+  }
+}
+
+void TestWaitForTimesOut()
+{
+  rtos::Mutex mutex;
+  rtos::ConditionVariable cv;
+
+  rtos::UniqueLock<rtos::Mutex> lock {mutex};
+  const auto start = std::chrono::steady_clock::now();
+  TEST_CHECK(!cv.WaitFor(lock, 20ms));
+  TEST_CHECK((std::chrono::steady_clock::now() - start) >= 20ms);
+  TEST_CHECK(lock.OwnsLock());
+
+  // The waiter has been removed, there is nothing to notify.
+  cv.NotifyAll();
+}
+
+void TestNotifyOne()
+{
+  rtos::Mutex mutex;
+  rtos::ConditionVariable cv;
+  std::atomic<TaskHandle_t> task {nullptr};
+  bool notified {false};
+
+  std::thread waiter([&]()
+  {
+    rtos::UniqueLock<rtos::Mutex> lock {mutex};
+    task.store(xTaskGetCurrentTaskHandle());
+    notified = cv.WaitFor(lock, 5s);
+  });
+
+  WaitUntilBlocked(task);
+  cv.NotifyOne();
+  waiter.join();
+  TEST_CHECK(notified);
+}
+
+void TestNotifyAll()
+{
+  constexpr int threadCount {4};
+  rtos::Mutex mutex;
+  rtos::ConditionVariable cv;
+  int ready {0};
+  bool go {false};
+  std::atomic<int> woken {0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&]()
+    {
+      rtos::UniqueLock<rtos::Mutex> lock {mutex};
+      ++ready;
+      if (cv.WaitFor(lock, 5s, [&go]() { return go; }))
+      {
+        ++woken;
+      }
+    });
+  }
+
+  for (;;)
+  {
+    rtos::LockGuard<rtos::Mutex> guard {mutex};
+    if (threadCount == ready)
+    {
+      go = true;
+      cv.NotifyAll();
+      break;
+    }
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  TEST_CHECK(threadCount == woken.load());
+}
+
+// A notification of another purpose on the index of the condition variable must neither end the wait nor leave the waiter linked.
+void TestForeignNotification()
+{
+  rtos::Mutex mutex;
+  rtos::ConditionVariable cv;
+  std::atomic<TaskHandle_t> task {nullptr};
+  bool notified {true};
+  std::chrono::steady_clock::duration waited {};
+
+  std::thread waiter([&]()
+  {
+    rtos::UniqueLock<rtos::Mutex> lock {mutex};
+    task.store(xTaskGetCurrentTaskHandle());
+    const auto start = std::chrono::steady_clock::now();
+    notified = cv.WaitFor(lock, 50ms);
+    waited = std::chrono::steady_clock::now() - start;
+  });
+
+  WaitUntilBlocked(task);
+#if defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+  xTaskNotifyGiveIndexed(task.load(), configTASK_NOTIFICATION_ARRAY_ENTRIES - 1);
+#else
+  xTaskNotifyGive(task.load());
+#endif
+  waiter.join();
+
+  // The remaining time is counted in ticks, so the wait may be shorter by a tick.
+  TEST_CHECK(!notified);
+  TEST_CHECK(waited >= 45ms);
+
+  // The waiter on the stack of the finished thread must not be notified.
+  cv.NotifyAll();
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("ConditionVariable WaitFor times out", TestWaitForTimesOut);
+  test::Run("ConditionVariable NotifyOne", TestNotifyOne);
+  test::Run("ConditionVariable NotifyAll", TestNotifyAll);
+  test::Run("ConditionVariable foreign notification", TestForeignNotification);
+  return test::Finish();
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/LockStats.hpp>
+#include <kernelapi/rtos/LockWatchdog.hpp>
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/RecursiveMutex.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Pages through the registered locks with a small buffer.
+bool FindLockStats(const void* lock, rtos::LockStats& stats)
+{
+  constexpr uint32_t bufferSize {2};
+  rtos::LockStats buffer[bufferSize];
+  uint32_t first {0};
+  uint32_t copied {0};
+
+  do
+  {
+    copied = rtos::GetLockStats(buffer, bufferSize, first);
+    for (uint32_t i = 0; i < copied; ++i)
+    {
+      if (lock == buffer[i].lock)
+      {
+        stats = buffer[i];
+        return true;
+      }
+    }
+    first += copied;
+  }
+  while (bufferSize == copied);
+
+  return false;
+}
+
+void TestAcquisitions()
+{
+  rtos::Mutex mutex;
+  rtos::RecursiveMutex recursiveMutex;
+  for (int i = 0; i < 10; ++i)
+  {
+    rtos::LockGuard<rtos::Mutex> guard {mutex};
+    rtos::LockGuard<rtos::RecursiveMutex> outer {recursiveMutex};
+    rtos::LockGuard<rtos::RecursiveMutex> inner {recursiveMutex};
+  }
+
+  rtos::LockStats stats {};
+  TEST_CHECK(FindLockStats(&mutex, stats));
+  TEST_CHECK(10 == stats.acquisitions);
+  TEST_CHECK(0 == stats.contentions);
+
+  TEST_CHECK(FindLockStats(&recursiveMutex, stats));
+  TEST_CHECK(20 == stats.acquisitions);
+  TEST_CHECK(0 == stats.contentions);
+
+  rtos::ResetLockStats();
+  TEST_CHECK(FindLockStats(&mutex, stats));
+  TEST_CHECK(0 == stats.acquisitions);
+}
+
+void TestContention()
+{
+  rtos::Mutex mutex;
+  mutex.Lock();
+
+  std::thread other([&mutex]()
+  {
+    TEST_CHECK(mutex.TryLockFor(5s));
+    mutex.Unlock();
+  });
+
+  std::this_thread::sleep_for(20ms);
+  mutex.Unlock();
+  other.join();
+
+  rtos::LockStats stats {};
+  TEST_CHECK(FindLockStats(&mutex, stats));
+  TEST_CHECK(2 == stats.acquisitions);
+  TEST_CHECK(1 == stats.contentions);
+  TEST_CHECK(0 < stats.maxWaitTime);
+  TEST_CHECK(stats.maxWaitTime == stats.totalWaitTime);
+  TEST_CHECK(0 < stats.maxHoldTime);
+}
+
+// The lock owners update the statistics, while another task copies and resets them.
+void TestConcurrentReset()
+{
+  constexpr int threadCount {4};
+  constexpr int iterations {5000};
+  rtos::Mutex mutex;
+  std::atomic<int> running {threadCount};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&mutex, &running]()
+    {
+      for (int j = 0; j < iterations; ++j)
+      {
+        rtos::LockGuard<rtos::Mutex> guard {mutex};
+      }
+      --running;
+    });
+  }
+
+  rtos::LockStats stats {};
+  while (0 != running.load())
+  {
+    TEST_CHECK(FindLockStats(&mutex, stats));
+    rtos::ResetLockStats();
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+// The events reported to OnLockWatchdogEvent() by the tasks of TestWatchdogHoldTime().
+std::vector<rtos::LockWatchdogEvent> watchdogEvents;
+
+void OnLockWatchdogEvent(const rtos::LockWatchdogEvent& event)
+{
+  watchdogEvents.push_back(event);
+}
+
+// The holder is reported with its priority at the acquisition, even if it was raised meanwhile.
+void TestWatchdogHoldTime()
+{
+  rtos::Mutex mutex;
+  watchdogEvents.clear();
+  rtos::SetLockWatchdog(OnLockWatchdogEvent, 5);
+
+  std::thread holder([&mutex]()
+  {
+    vTaskPrioritySet(nullptr, 3);
+    rtos::LockGuard<rtos::Mutex> guard {mutex};
+    vTaskPrioritySet(nullptr, 7);
+    std::this_thread::sleep_for(20ms);
+  });
+  holder.join();
+
+  rtos::SetLockWatchdog(nullptr, 0);
+  TEST_CHECK(1 == watchdogEvents.size());
+  TEST_CHECK(rtos::LockWatchdogEventType::HoldTimeExceeded == watchdogEvents[0].type);
+  TEST_CHECK(&mutex == watchdogEvents[0].lock);
+  TEST_CHECK(3 == watchdogEvents[0].holderPriority);
+  TEST_CHECK(5 < watchdogEvents[0].holdTime);
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("LockStats acquisitions", TestAcquisitions);
+  test::Run("LockStats contention", TestContention);
+  test::Run("LockStats concurrent reset", TestConcurrentReset);
+  test::Run("LockWatchdog hold time", TestWatchdogHoldTime);
+  return test::Finish();
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// Contention benchmark of the host backend, it is built but not run by ctest.
+// Prints one CSV line per primitive and thread count, the header line starts with "benchmark".
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/RecursiveMutex.hpp>
+#include <kernelapi/rtos/SpinLock.hpp>
+
+namespace
+{
+
+constexpr uint32_t iterations {200000};
+
+// Measures the average duration of a locked increment, while \a threadCount threads compete for the lock.
+template <typename MUTEX>
+void Measure(const char* primitive, MUTEX& mutex, uint32_t threadCount)
+{
+  uint64_t counter {0};
+  std::vector<std::thread> threads;
+
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&mutex, &counter]()
+    {
+      for (uint32_t j = 0; j < iterations; ++j)
+      {
+        rtos::LockGuard<MUTEX> guard {mutex};
+        ++counter;
+      }
+    });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+  const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+  printf("mutex,%s,%u,%llu\n", primitive, static_cast<unsigned>(threadCount),
+         static_cast<unsigned long long>(duration.count() / counter));
+}
+
+} // namespace
+
+int main()
+{
+  printf("benchmark,primitive,threads,ns_per_lock\n");
+
+  for (uint32_t threadCount : {1U, 2U, 4U})
+  {
+    rtos::Mutex mutex;
+    Measure("Mutex", mutex, threadCount);
+
+    rtos::Mutex adaptiveMutex {1000};
+    Measure("Mutex(adaptive)", adaptiveMutex, threadCount);
+
+    rtos::RecursiveMutex recursiveMutex;
+    Measure("RecursiveMutex", recursiveMutex, threadCount);
+
+    rtos::SpinLock spinLock;
+    Measure("SpinLock", spinLock, threadCount);
+  }
+
+  return 0;
+}
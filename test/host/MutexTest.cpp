@@ -0,0 +1,162 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/Mutex.hpp>
+#include <kernelapi/rtos/UniqueLock.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Increments a counter, which is only protected by the mutex, from several threads.
+template <typename MUTEX>
+void CheckMutualExclusion(MUTEX& mutex)
+{
+  constexpr int threadCount {4};
+  constexpr int iterations {20000};
+  uint32_t counter {0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&mutex, &counter]()
+    {
+      for (int j = 0; j < iterations; ++j)
+      {
+        rtos::LockGuard<MUTEX> guard {mutex};
+        ++counter;
+      }
+    });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  TEST_CHECK((threadCount * iterations) == counter);
+}
+
+void TestLockUnlock()
+{
+  rtos::Mutex mutex;
+  TEST_CHECK(mutex.IsValid());
+  TEST_CHECK(mutex.IsCreated());
+  TEST_CHECK(!mutex.IsLocked());
+
+  mutex.Lock();
+  TEST_CHECK(mutex.IsLocked());
+  mutex.Unlock();
+  TEST_CHECK(!mutex.IsLocked());
+
+  TEST_CHECK(mutex.TryLock());
+  mutex.Unlock();
+}
+
+void TestTryLockForTimesOut()
+{
+  rtos::Mutex mutex;
+  mutex.Lock();
+
+  std::thread other([&mutex]()
+  {
+    TEST_CHECK(!mutex.TryLock());
+
+    const auto start = std::chrono::steady_clock::now();
+    TEST_CHECK(!mutex.TryLockFor(20ms));
+    TEST_CHECK((std::chrono::steady_clock::now() - start) >= 20ms);
+  });
+  other.join();
+
+  mutex.Unlock();
+}
+
+void TestTryLockForSucceedsWhenReleased()
+{
+  rtos::Mutex mutex;
+  mutex.Lock();
+
+  std::thread other([&mutex]()
+  {
+    TEST_CHECK(mutex.TryLockFor(5s));
+    mutex.Unlock();
+  });
+
+  std::this_thread::sleep_for(10ms);
+  mutex.Unlock();
+  other.join();
+}
+
+void TestLazyCreate()
+{
+  rtos::Mutex mutex {rtos::lazyCreate};
+  TEST_CHECK(mutex.IsValid());
+  TEST_CHECK(!mutex.IsCreated());
+  TEST_CHECK(!mutex.IsLocked());
+
+  // Concurrent first uses create exactly one native mutex.
+  CheckMutualExclusion(mutex);
+  TEST_CHECK(mutex.IsCreated());
+}
+
+void TestAdaptive()
+{
+  rtos::Mutex mutex {1000};
+  TEST_CHECK(1000 == mutex.GetMaxSpinCount());
+  CheckMutualExclusion(mutex);
+
+  // The spin phase is part of the timeout.
+  mutex.Lock();
+  std::thread other([&mutex]()
+  {
+    const auto start = std::chrono::steady_clock::now();
+    TEST_CHECK(!mutex.TryLockFor(20ms));
+    TEST_CHECK((std::chrono::steady_clock::now() - start) < 2s);
+  });
+  other.join();
+  mutex.Unlock();
+}
+
+void TestUniqueLock()
+{
+  rtos::Mutex mutex;
+  {
+    rtos::UniqueLock<rtos::Mutex> lock {mutex, rtos::deferLock};
+    TEST_CHECK(!lock.OwnsLock());
+    TEST_CHECK(lock.TryLock());
+    TEST_CHECK(mutex.IsLocked());
+
+    // Moving transfers the ownership without unlocking.
+    rtos::UniqueLock<rtos::Mutex> moved {std::move(lock)};
+    TEST_CHECK(!lock.OwnsLock());
+    TEST_CHECK(moved.OwnsLock());
+    TEST_CHECK(mutex.IsLocked());
+  }
+  TEST_CHECK(!mutex.IsLocked());
+
+  CheckMutualExclusion(mutex);
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("Mutex Lock/Unlock", TestLockUnlock);
+  test::Run("Mutex TryLockFor times out", TestTryLockForTimesOut);
+  test::Run("Mutex TryLockFor succeeds when released", TestTryLockForSucceedsWhenReleased);
+  test::Run("Mutex LazyCreate", TestLazyCreate);
+  test::Run("Mutex adaptive mode", TestAdaptive);
+  test::Run("UniqueLock", TestUniqueLock);
+  return test::Finish();
+}
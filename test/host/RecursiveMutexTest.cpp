@@ -0,0 +1,125 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <kernelapi/rtos/LockGuard.hpp>
+#include <kernelapi/rtos/RecursiveMutex.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+void TestRecursion(rtos::RecursiveMutex::Recursion recursion)
+{
+  rtos::RecursiveMutex mutex {recursion};
+  TEST_CHECK(mutex.IsValid());
+
+  mutex.Lock();
+  TEST_CHECK(mutex.TryLock());
+  TEST_CHECK(mutex.TryLockFor(10ms));
+  TEST_CHECK(mutex.IsLocked());
+
+  // Another thread cannot lock the mutex until it was unlocked as often as it was locked.
+  std::thread other([&mutex]() { TEST_CHECK(!mutex.TryLockFor(10ms)); });
+  other.join();
+
+  mutex.Unlock();
+  mutex.Unlock();
+  TEST_CHECK(mutex.IsLocked());
+  mutex.Unlock();
+  TEST_CHECK(!mutex.IsLocked());
+
+  std::thread next([&mutex]()
+  {
+    TEST_CHECK(mutex.TryLock());
+    mutex.Unlock();
+  });
+  next.join();
+}
+
+// With Recursion::OwnerCached only the outermost Lock() and Unlock() take and give the native mutex.
+void TestOwnerCachedDepth()
+{
+  constexpr int depth {100};
+  rtos::RecursiveMutex mutex {rtos::RecursiveMutex::Recursion::OwnerCached};
+
+  for (int i = 0; i < depth; ++i)
+  {
+    TEST_CHECK(mutex.TryLock());
+  }
+
+  for (int i = 1; i < depth; ++i)
+  {
+    mutex.Unlock();
+    TEST_CHECK(mutex.IsLocked());
+  }
+
+  std::thread other([&mutex]() { TEST_CHECK(!mutex.TryLockFor(10ms)); });
+  other.join();
+
+  mutex.Unlock();
+  TEST_CHECK(!mutex.IsLocked());
+
+  // The cached owner has been cleared, another thread starts with a depth of 1.
+  std::thread next([&mutex]()
+  {
+    TEST_CHECK(mutex.TryLock());
+    TEST_CHECK(mutex.TryLock());
+    mutex.Unlock();
+    TEST_CHECK(mutex.IsLocked());
+    mutex.Unlock();
+  });
+  next.join();
+  TEST_CHECK(!mutex.IsLocked());
+}
+
+void TestMutualExclusion(rtos::RecursiveMutex::Recursion recursion)
+{
+  constexpr int threadCount {4};
+  constexpr int iterations {10000};
+  rtos::RecursiveMutex mutex {rtos::lazyCreate, recursion};
+  uint32_t counter {0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < threadCount; ++i)
+  {
+    threads.emplace_back([&mutex, &counter]()
+    {
+      for (int j = 0; j < iterations; ++j)
+      {
+        rtos::LockGuard<rtos::RecursiveMutex> outer {mutex};
+        rtos::LockGuard<rtos::RecursiveMutex> inner {mutex};
+        ++counter;
+      }
+    });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  TEST_CHECK((threadCount * iterations) == counter);
+  TEST_CHECK(!mutex.IsLocked());
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("RecursiveMutex Native recursion", []() { TestRecursion(rtos::RecursiveMutex::Recursion::Native); });
+  test::Run("RecursiveMutex OwnerCached recursion", []() { TestRecursion(rtos::RecursiveMutex::Recursion::OwnerCached); });
+  test::Run("RecursiveMutex OwnerCached depth", TestOwnerCachedDepth);
+  test::Run("RecursiveMutex Native mutual exclusion", []() { TestMutualExclusion(rtos::RecursiveMutex::Recursion::Native); });
+  test::Run("RecursiveMutex OwnerCached mutual exclusion", []() { TestMutualExclusion(rtos::RecursiveMutex::Recursion::OwnerCached); });
+  return test::Finish();
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/StreamBuffer.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+// Returns true, if a notification of the stream buffer has been left over for the calling task.
+bool HasLeftOverNotification()
+{
+#if defined(configTASK_NOTIFICATION_ARRAY_ENTRIES) && (configTASK_NOTIFICATION_ARRAY_ENTRIES > 1)
+  return (0 != ulTaskNotifyTakeIndexed(configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, pdTRUE, 0));
+#else
+  return (0 != ulTaskNotifyTake(pdTRUE, 0));
+#endif
+}
+
+void TestReceiveTimesOut()
+{
+  rtos::StreamBuffer<16> buffer;
+  uint8_t data[4] {};
+
+  const auto start = std::chrono::steady_clock::now();
+  TEST_CHECK(0 == buffer.Receive(data, sizeof(data), 20ms));
+  TEST_CHECK((std::chrono::steady_clock::now() - start) >= 15ms);
+  TEST_CHECK(!HasLeftOverNotification());
+}
+
+// The bytes are passed with short timeouts, so the waits often time out while the other side wakes them up.
+// Neither the writer nor the reader must be left with a notification.
+void TestNoLeftOverNotification()
+{
+  constexpr uint32_t byteCount {20000};
+  rtos::StreamBuffer<16> buffer;
+
+  std::thread writer([&buffer]()
+  {
+    for (uint32_t i = 0; i < byteCount;)
+    {
+      const uint8_t byte = static_cast<uint8_t>(i);
+      i += static_cast<uint32_t>(buffer.Send(&byte, 1, 1));
+      TEST_CHECK(!HasLeftOverNotification());
+    }
+  });
+
+  uint32_t received {0};
+  bool ordered {true};
+  while (received < byteCount)
+  {
+    uint8_t data[8] {};
+    const size_t read = buffer.Receive(data, sizeof(data), 1);
+    for (size_t i = 0; i < read; ++i)
+    {
+      ordered = ordered && (static_cast<uint8_t>(received + i) == data[i]);
+    }
+    received += static_cast<uint32_t>(read);
+    TEST_CHECK(!HasLeftOverNotification());
+  }
+
+  writer.join();
+  TEST_CHECK(ordered);
+  TEST_CHECK(buffer.IsEmpty());
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("StreamBuffer Receive times out", TestReceiveTimesOut);
+  test::Run("StreamBuffer no left over notification", TestNoLeftOverNotification);
+  return test::Finish();
+}
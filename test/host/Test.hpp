@@ -0,0 +1,61 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_FDBD856740894F6CBB2A0D6DB2F31911
+#define HEADER_FDBD856740894F6CBB2A0D6DB2F31911
+
+#include <atomic>
+#include <cstdio>
+
+namespace test
+{
+
+/**
+ * @returns the number of failed checks of the test executable, checks may fail in any thread.
+ */
+inline std::atomic<int>& GetFailures()
+{
+  static std::atomic<int> failures {0};
+  return failures;
+}
+
+/**
+ * @brief Runs a test case and prints its name.
+ * @param[in] name The name of the test case.
+ * @param[in] testCase The test case.
+ */
+template <typename TEST_CASE>
+void Run(const char* name, TEST_CASE&& testCase)
+{
+  const int failures = GetFailures();
+  testCase();
+  printf("%s %s\n", (failures == GetFailures()) ? "PASS" : "FAIL", name);
+}
+
+/**
+ * @returns the exit code of the test executable, non-zero if any check failed.
+ */
+inline int Finish()
+{
+  return (0 == GetFailures()) ? 0 : 1;
+}
+
+} // namespace test
+
+/**
+ * @brief Checks the condition, a failed check is printed and fails the test executable, but the test case continues.
+ */
+#define TEST_CHECK(condition)                                                       \
+  do                                                                                \
+  {                                                                                 \
+    if (!(condition))                                                               \
+    {                                                                               \
+      printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition);          \
+      ++test::GetFailures();                                                        \
+    }                                                                               \
+  }                                                                                 \
+  while (false)
+
+#endif // HEADER_FDBD856740894F6CBB2A0D6DB2F31911
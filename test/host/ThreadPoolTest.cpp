@@ -0,0 +1,120 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstdint>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include <kernelapi/rtos/ThreadPool.hpp>
+
+#include "Test.hpp"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+
+using Pool = rtos::ThreadPool<16, 32, 4096>;
+
+void TestSubmit()
+{
+  constexpr uint32_t jobCount {100};
+  Pool pool {"pool"};
+  TEST_CHECK(pool.Start());
+
+  std::atomic<uint32_t> counter {0};
+  for (uint32_t i = 0; i < jobCount; ++i)
+  {
+    TEST_CHECK(pool.Submit([&counter]() { ++counter; }, 5s));
+  }
+
+  TEST_CHECK(pool.WaitAll(5s));
+  TEST_CHECK(jobCount == counter.load());
+  TEST_CHECK(0 == pool.GetPending());
+}
+
+// The jobs submitted by a job are pushed to the deque of its worker, the other worker steals them.
+void TestStealing()
+{
+  constexpr uint32_t childCount {32};
+  Pool pool {"pool"};
+  TEST_CHECK(pool.Start());
+
+  std::atomic<uint32_t> counter {0};
+  std::atomic<uint32_t> cores {0};
+  auto child = [&counter, &cores]()
+  {
+    cores.fetch_or(1U << xPortGetCoreID());
+    vTaskDelay(1);
+    ++counter;
+  };
+
+  TEST_CHECK(pool.Submit([&pool, &child]()
+  {
+    for (uint32_t i = 0; i < childCount; ++i)
+    {
+      TEST_CHECK(pool.Submit(child));
+    }
+  }));
+
+  // WaitAll() includes the jobs submitted by jobs.
+  TEST_CHECK(pool.WaitAll(5s));
+  TEST_CHECK(childCount == counter.load());
+  TEST_CHECK(((1U << Pool::GetWorkerCount()) - 1U) == cores.load());
+}
+
+void TestWaitAllTimesOut()
+{
+  Pool pool {"pool"};
+  TEST_CHECK(pool.Start());
+
+  std::atomic<bool> release {false};
+  TEST_CHECK(pool.Submit([&release]()
+  {
+    while (!release.load())
+    {
+      vTaskDelay(1);
+    }
+  }));
+
+  TEST_CHECK(!pool.WaitAll(20ms));
+  TEST_CHECK(1 == pool.GetPending());
+
+  release.store(true);
+  TEST_CHECK(pool.WaitAll(5s));
+}
+
+// A lost wakeup of a worker or of the waiting task, e.g. by a missing fence, lets WaitAll() time out.
+// The last job finishing concurrently with the end of WaitAll() must not leave a notification over.
+void TestRepeatedWaitAll()
+{
+  constexpr uint32_t rounds {1000};
+  Pool pool {"pool"};
+  TEST_CHECK(pool.Start());
+
+  std::atomic<uint32_t> counter {0};
+  for (uint32_t round = 0; round < rounds; ++round)
+  {
+    TEST_CHECK(pool.Submit([&counter]() { ++counter; }));
+    (void)pool.WaitAll(0);
+    TEST_CHECK(pool.WaitAll(5s));
+  }
+
+  TEST_CHECK(rounds == counter.load());
+  TEST_CHECK(0 == ulTaskNotifyTake(pdTRUE, 0));
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("ThreadPool Submit", TestSubmit);
+  test::Run("ThreadPool stealing", TestStealing);
+  test::Run("ThreadPool WaitAll times out", TestWaitAllTimesOut);
+  test::Run("ThreadPool repeated WaitAll", TestRepeatedWaitAll);
+  return test::Finish();
+}
@@ -0,0 +1,139 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <kernelapi/rtos/SeqLock.hpp>
+#include <kernelapi/rtos/TripleBuffer.hpp>
+
+#include "Test.hpp"
+
+namespace
+{
+
+// Every field holds the same value, so a torn read is detected.
+struct Sample
+{
+  uint32_t values[16];
+};
+
+bool IsConsistent(const Sample& sample)
+{
+  for (uint32_t value : sample.values)
+  {
+    if (value != sample.values[0])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+Sample MakeSample(uint32_t value)
+{
+  Sample sample {};
+  for (uint32_t& field : sample.values)
+  {
+    field = value;
+  }
+  return sample;
+}
+
+void TestTripleBuffer()
+{
+  constexpr size_t readerCount {2};
+  constexpr uint32_t publications {100000};
+  rtos::TripleBuffer<Sample, readerCount> buffer;
+
+  TEST_CHECK(0 == buffer.GetSequence());
+  TEST_CHECK(0 == buffer.Read()->values[0]);
+
+  std::atomic<bool> done {false};
+  std::vector<std::thread> readers;
+  for (size_t i = 0; i < readerCount; ++i)
+  {
+    readers.emplace_back([&buffer, &done]()
+    {
+      uint32_t previous {0};
+      while (!done.load())
+      {
+        const auto snapshot = buffer.Read();
+        TEST_CHECK(IsConsistent(*snapshot));
+
+        // The values are published in order, a reader never sees an older value after a newer one.
+        TEST_CHECK(previous <= snapshot->values[0]);
+        previous = snapshot->values[0];
+      }
+    });
+  }
+
+  for (uint32_t value = 1; value <= publications; ++value)
+  {
+    Sample& next = buffer.BeginWrite();
+    next = MakeSample(value);
+    buffer.Publish();
+  }
+  done.store(true);
+
+  for (std::thread& reader : readers)
+  {
+    reader.join();
+  }
+
+  Sample latest {};
+  TEST_CHECK(publications == buffer.ReadCopy(latest));
+  TEST_CHECK(publications == latest.values[0]);
+}
+
+void TestSeqLock()
+{
+  constexpr uint32_t writes {100000};
+  rtos::SeqLock<Sample> seqLock {MakeSample(0)};
+
+  std::atomic<bool> done {false};
+  std::thread reader([&seqLock, &done]()
+  {
+    uint32_t previous {0};
+    while (!done.load())
+    {
+      const Sample sample = seqLock.Read();
+      TEST_CHECK(IsConsistent(sample));
+      TEST_CHECK(previous <= sample.values[0]);
+      previous = sample.values[0];
+    }
+  });
+
+  // Two writers are serialized by the SpinLock.
+  std::thread writer([&seqLock]()
+  {
+    for (uint32_t i = 0; i < writes; ++i)
+    {
+      seqLock.Modify([](Sample& sample) { sample = MakeSample(sample.values[0] + 1U); });
+    }
+  });
+  for (uint32_t i = 0; i < writes; ++i)
+  {
+    seqLock.Modify([](Sample& sample) { sample = MakeSample(sample.values[0] + 1U); });
+  }
+  writer.join();
+  done.store(true);
+  reader.join();
+
+  const Sample sample = seqLock.Read();
+  TEST_CHECK(IsConsistent(sample));
+  TEST_CHECK((2U * writes) == sample.values[0]);
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("TripleBuffer concurrent readers", TestTripleBuffer);
+  test::Run("SeqLock concurrent writers and reader", TestSeqLock);
+  return test::Finish();
+}
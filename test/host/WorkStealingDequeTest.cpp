@@ -0,0 +1,112 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <kernelapi/rtos/WorkStealingDeque.hpp>
+
+#include "Test.hpp"
+
+namespace
+{
+
+void TestOwner()
+{
+  rtos::detail::WorkStealingDeque<uint32_t, 4> deque;
+  uint32_t item {0};
+
+  TEST_CHECK(deque.IsEmpty());
+  TEST_CHECK(!deque.Pop(item));
+  TEST_CHECK(!deque.Steal(item));
+
+  for (uint32_t i = 1; i <= 4; ++i)
+  {
+    TEST_CHECK(deque.Push(i));
+  }
+  TEST_CHECK(!deque.Push(5));
+
+  // The owner pops the newest item, a thief steals the oldest one.
+  TEST_CHECK(deque.Pop(item) && (4 == item));
+  TEST_CHECK(deque.Steal(item) && (1 == item));
+  TEST_CHECK(deque.Pop(item) && (3 == item));
+  TEST_CHECK(deque.Pop(item) && (2 == item));
+  TEST_CHECK(!deque.Pop(item));
+  TEST_CHECK(deque.IsEmpty());
+}
+
+// Each pushed item is taken exactly once, either by the owner or by one of the thieves.
+void TestConcurrentSteal()
+{
+  constexpr uint32_t itemCount {100000};
+  constexpr size_t thiefCount {3};
+  rtos::detail::WorkStealingDeque<uint32_t, 64> deque;
+  std::vector<std::atomic<uint8_t>> taken(itemCount);
+  std::atomic<bool> done {false};
+
+  std::vector<std::thread> thieves;
+  for (size_t i = 0; i < thiefCount; ++i)
+  {
+    thieves.emplace_back([&deque, &taken, &done]()
+    {
+      uint32_t item {0};
+      while (!done.load())
+      {
+        if (deque.Steal(item))
+        {
+          taken[item].fetch_add(1U);
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  uint32_t item {0};
+  for (uint32_t next = 0; next < itemCount;)
+  {
+    if (deque.Push(next))
+    {
+      ++next;
+    }
+
+    // Pop every other round, so the owner and the thieves compete for the last items.
+    if ((0 == (next % 2U)) && deque.Pop(item))
+    {
+      taken[item].fetch_add(1U);
+    }
+  }
+
+  while (deque.Pop(item))
+  {
+    taken[item].fetch_add(1U);
+  }
+  done.store(true);
+
+  for (std::thread& thief : thieves)
+  {
+    thief.join();
+  }
+
+  uint32_t wrong {0};
+  for (const std::atomic<uint8_t>& count : taken)
+  {
+    wrong += (1U == count.load()) ? 0U : 1U;
+  }
+  TEST_CHECK(0 == wrong);
+}
+
+} // namespace
+
+int main()
+{
+  test::Run("WorkStealingDeque owner", TestOwner);
+  test::Run("WorkStealingDeque concurrent steal", TestConcurrentSteal);
+  return test::Finish();
+}
@@ -0,0 +1,585 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// The emulated kernel runs each task in a std::thread, all of them concurrently: There are no priorities and no preemption.
+// All kernel objects are protected by a single mutex, every change wakes up all blocked tasks, which check their condition again.
+// A suspended or deleted task parks in its next kernel call, a deleted task never returns from it.
+// Threads, which are not created by the kernel, e.g. the main thread, get a task control block on their first kernel call.
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+struct tskTaskControlBlock
+{
+  uint32_t notifications[configTASK_NOTIFICATION_ARRAY_ENTRIES] {}; /** The notification values. */
+  UBaseType_t priority {1};                                         /** The priority, only stored. */
+  BaseType_t core {tskNO_AFFINITY};                                 /** The core the task is pinned to. */
+  bool suspendRequested {false};                                    /** true from vTaskSuspend() until vTaskResume(). */
+  bool suspended {false};                                           /** true while the task is parked. */
+  bool deleted {false};                                             /** true once vTaskDelete() was called. */
+  bool blocked {false};                                             /** true while the task waits for a kernel object. */
+};
+
+struct QueueDefinition
+{
+  enum class Type
+  {
+    Queue,
+    Mutex,
+    RecursiveMutex
+  };
+
+  Type type {Type::Queue};                    /** The kind of the kernel object. */
+  size_t length {0};                          /** The maximum number of items. */
+  size_t itemSize {0};                        /** The size of an item in bytes. */
+  std::deque<std::vector<uint8_t>> items {};  /** The queued items. */
+  TaskHandle_t holder {nullptr};              /** The task holding the mutex. */
+  UBaseType_t depth {0};                      /** The recursion depth of the holder of a recursive mutex. */
+};
+
+namespace
+{
+
+// The kernel objects are never destroyed, a parked thread may still wait for them when the process exits.
+std::mutex& GetKernelMutex()
+{
+  static std::mutex& mutex = *new std::mutex;
+  return mutex;
+}
+
+std::condition_variable& GetKernelChanged()
+{
+  static std::condition_variable& changed = *new std::condition_variable;
+  return changed;
+}
+
+// The task control blocks are never freed, the handle of a deleted task may still be used, e.g. by eTaskGetState().
+TaskHandle_t CreateTcb()
+{
+  static std::vector<std::unique_ptr<tskTaskControlBlock>>& tcbs = *new std::vector<std::unique_ptr<tskTaskControlBlock>>;
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  tcbs.push_back(std::make_unique<tskTaskControlBlock>());
+  return tcbs.back().get();
+}
+
+thread_local TaskHandle_t currentTask {nullptr};
+
+TaskHandle_t GetSelf()
+{
+  if (nullptr == currentTask)
+  {
+    currentTask = CreateTcb();
+  }
+  return currentTask;
+}
+
+// Parks the calling task while it is suspended, forever if it is deleted. To be called with the kernel mutex locked.
+void Park(std::unique_lock<std::mutex>& lock, TaskHandle_t self)
+{
+  while (self->deleted || self->suspendRequested)
+  {
+    if (!self->suspended)
+    {
+      self->suspended = true;
+      GetKernelChanged().notify_all();
+    }
+    GetKernelChanged().wait(lock);
+  }
+  self->suspended = false;
+}
+
+// Blocks the calling task until the condition is met or the timeout has been reached. To be called with the kernel mutex locked.
+template <typename CONDITION>
+bool Wait(std::unique_lock<std::mutex>& lock, TaskHandle_t self, TickType_t timeout, CONDITION condition)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+
+  for (;;)
+  {
+    Park(lock, self);
+    if (condition())
+    {
+      return true;
+    }
+
+    if ((portMAX_DELAY != timeout) && (std::chrono::steady_clock::now() >= deadline))
+    {
+      return false;
+    }
+
+    self->blocked = true;
+    if (portMAX_DELAY == timeout)
+    {
+      GetKernelChanged().wait(lock);
+    }
+    else
+    {
+      GetKernelChanged().wait_until(lock, deadline);
+    }
+    self->blocked = false;
+  }
+}
+
+uintptr_t GetThreadTag()
+{
+  static thread_local const char tag {0};
+  return reinterpret_cast<uintptr_t>(&tag);
+}
+
+BaseType_t Send(QueueHandle_t queue, const void* item, TickType_t timeout, bool front)
+{
+  const TaskHandle_t self = GetSelf();
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  if (!Wait(lock, self, timeout, [queue]() { return queue->items.size() < queue->length; }))
+  {
+    return pdFAIL;
+  }
+
+  const uint8_t* const bytes = static_cast<const uint8_t*>(item);
+  if (front)
+  {
+    queue->items.emplace_front(bytes, bytes + queue->itemSize);
+  }
+  else
+  {
+    queue->items.emplace_back(bytes, bytes + queue->itemSize);
+  }
+  GetKernelChanged().notify_all();
+  return pdPASS;
+}
+
+BaseType_t Receive(QueueHandle_t queue, void* item, TickType_t timeout, bool peek)
+{
+  const TaskHandle_t self = GetSelf();
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  if (!Wait(lock, self, timeout, [queue]() { return !queue->items.empty(); }))
+  {
+    return pdFAIL;
+  }
+
+  std::memcpy(item, queue->items.front().data(), queue->itemSize);
+  if (!peek)
+  {
+    queue->items.pop_front();
+    GetKernelChanged().notify_all();
+  }
+  return pdPASS;
+}
+
+QueueHandle_t CreateMutex(QueueDefinition::Type type)
+{
+  QueueHandle_t mutex = new QueueDefinition;
+  mutex->type = type;
+  mutex->length = 1;
+  return mutex;
+}
+
+} // namespace
+
+void vPortEnterCritical(portMUX_TYPE* mux)
+{
+  (void)xPortEnterCriticalTimeout(mux, portMUX_NO_TIMEOUT);
+}
+
+void vPortExitCritical(portMUX_TYPE* mux)
+{
+  if (0 == --mux->count)
+  {
+    mux->owner.store(0, std::memory_order_release);
+  }
+}
+
+BaseType_t xPortEnterCriticalTimeout(portMUX_TYPE* mux, BaseType_t timeout)
+{
+  const uintptr_t self = GetThreadTag();
+  if (self == mux->owner.load(std::memory_order_relaxed))
+  {
+    ++mux->count;
+    return pdPASS;
+  }
+
+  uintptr_t expected {0};
+  while (!mux->owner.compare_exchange_weak(expected, self, std::memory_order_acquire, std::memory_order_relaxed))
+  {
+    if (portMUX_TRY_LOCK == timeout)
+    {
+      return pdFAIL;
+    }
+    expected = 0;
+    std::this_thread::yield();
+  }
+  mux->count = 1;
+  return pdPASS;
+}
+
+BaseType_t xPortGetCoreID()
+{
+  const TaskHandle_t self = GetSelf();
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  return (tskNO_AFFINITY == self->core) ? 0 : self->core;
+}
+
+void* pvPortMalloc(size_t size)
+{
+  return std::malloc(size);
+}
+
+void vPortFree(void* memory)
+{
+  std::free(memory);
+}
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t function, const char*, uint32_t, void* param,
+                                           UBaseType_t priority, StackType_t*, StaticTask_t*, BaseType_t core)
+{
+  const TaskHandle_t task = CreateTcb();
+  {
+    std::lock_guard<std::mutex> guard {GetKernelMutex()};
+    task->priority = priority;
+    task->core = core;
+  }
+
+  std::thread([function, param, task]()
+  {
+    currentTask = task;
+    {
+      std::unique_lock<std::mutex> lock {GetKernelMutex()};
+      Park(lock, task);
+    }
+    function(param);
+
+    // A task must not return from its function.
+    std::abort();
+  }).detach();
+
+  return task;
+}
+
+void vTaskDelete(TaskHandle_t task)
+{
+  const TaskHandle_t self = GetSelf();
+  task = (nullptr != task) ? task : self;
+
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  task->deleted = true;
+  GetKernelChanged().notify_all();
+  if (task == self)
+  {
+    Park(lock, self);
+  }
+}
+
+void vTaskSuspend(TaskHandle_t task)
+{
+  const TaskHandle_t self = GetSelf();
+  task = (nullptr != task) ? task : self;
+
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  task->suspendRequested = true;
+  GetKernelChanged().notify_all();
+  if (task == self)
+  {
+    Park(lock, self);
+  }
+}
+
+void vTaskResume(TaskHandle_t task)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  task->suspendRequested = false;
+  GetKernelChanged().notify_all();
+}
+
+eTaskState eTaskGetState(TaskHandle_t task)
+{
+  const TaskHandle_t self = GetSelf();
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  if (task->deleted)
+  {
+    return eDeleted;
+  }
+  if (task->suspended)
+  {
+    return eSuspended;
+  }
+  if (task == self)
+  {
+    return eRunning;
+  }
+  return task->blocked ? eBlocked : eReady;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle()
+{
+  return GetSelf();
+}
+
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task)
+{
+  task = (nullptr != task) ? task : GetSelf();
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  return task->priority;
+}
+
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority)
+{
+  task = (nullptr != task) ? task : GetSelf();
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  task->priority = priority;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t)
+{
+  return 0;
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+  const TaskHandle_t self = GetSelf();
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  (void)Wait(lock, self, ticks, []() { return false; });
+}
+
+TickType_t xTaskGetTickCount()
+{
+  static const auto start = std::chrono::steady_clock::now();
+  return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void vTaskSetTimeOutState(TimeOut_t* timeOut)
+{
+  timeOut->timeOnEntering = xTaskGetTickCount();
+}
+
+BaseType_t xTaskCheckForTimeOut(TimeOut_t* timeOut, TickType_t* remaining)
+{
+  if (portMAX_DELAY == *remaining)
+  {
+    return pdFALSE;
+  }
+
+  const TickType_t elapsed = xTaskGetTickCount() - timeOut->timeOnEntering;
+  if (elapsed < *remaining)
+  {
+    *remaining -= elapsed;
+    vTaskSetTimeOutState(timeOut);
+    return pdFALSE;
+  }
+
+  *remaining = 0;
+  return pdTRUE;
+}
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  ++task->notifications[index];
+  GetKernelChanged().notify_all();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t* higherPriorityTaskWoken)
+{
+  (void)xTaskNotifyGiveIndexed(task, index);
+  if (nullptr != higherPriorityTaskWoken)
+  {
+    *higherPriorityTaskWoken = pdFALSE;
+  }
+}
+
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clearOnExit, TickType_t timeout)
+{
+  const TaskHandle_t self = GetSelf();
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  if (!Wait(lock, self, timeout, [self, index]() { return 0 != self->notifications[index]; }))
+  {
+    return 0;
+  }
+
+  const uint32_t value = self->notifications[index];
+  self->notifications[index] = (pdFALSE != clearOnExit) ? 0 : (value - 1U);
+  return value;
+}
+
+QueueHandle_t xQueueCreateStatic(UBaseType_t length, UBaseType_t itemSize, uint8_t*, StaticQueue_t*)
+{
+  QueueHandle_t queue = new QueueDefinition;
+  queue->length = length;
+  queue->itemSize = itemSize;
+  return queue;
+}
+
+void vQueueDelete(QueueHandle_t queue)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  delete queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t timeout)
+{
+  return Send(queue, item, timeout, false);
+}
+
+BaseType_t xQueueSendToFront(QueueHandle_t queue, const void* item, TickType_t timeout)
+{
+  return Send(queue, item, timeout, true);
+}
+
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item)
+{
+  {
+    std::lock_guard<std::mutex> guard {GetKernelMutex()};
+    queue->items.clear();
+  }
+  return Send(queue, item, 0, false);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t timeout)
+{
+  return Receive(queue, item, timeout, false);
+}
+
+BaseType_t xQueuePeek(QueueHandle_t queue, void* item, TickType_t timeout)
+{
+  return Receive(queue, item, timeout, true);
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  queue->items.clear();
+  GetKernelChanged().notify_all();
+  return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken)
+{
+  *higherPriorityTaskWoken = pdFALSE;
+  return Send(queue, item, 0, false);
+}
+
+BaseType_t xQueueOverwriteFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken)
+{
+  *higherPriorityTaskWoken = pdFALSE;
+  return xQueueOverwrite(queue, item);
+}
+
+BaseType_t xQueueReceiveFromISR(QueueHandle_t queue, void* item, BaseType_t* higherPriorityTaskWoken)
+{
+  *higherPriorityTaskWoken = pdFALSE;
+  return Receive(queue, item, 0, false);
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  return static_cast<UBaseType_t>(queue->items.size());
+}
+
+UBaseType_t uxQueueMessagesWaitingFromISR(QueueHandle_t queue)
+{
+  return uxQueueMessagesWaiting(queue);
+}
+
+UBaseType_t uxQueueSpacesAvailable(QueueHandle_t queue)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  return static_cast<UBaseType_t>(queue->length - queue->items.size());
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+  return CreateMutex(QueueDefinition::Type::Mutex);
+}
+
+SemaphoreHandle_t xSemaphoreCreateRecursiveMutex()
+{
+  return CreateMutex(QueueDefinition::Type::RecursiveMutex);
+}
+
+// Like the kernel, a task taking a non-recursive mutex it already holds blocks until the timeout has been reached.
+BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t timeout)
+{
+  const TaskHandle_t self = GetSelf();
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  if (!Wait(lock, self, timeout, [mutex]() { return nullptr == mutex->holder; }))
+  {
+    return pdFALSE;
+  }
+
+  mutex->holder = self;
+  mutex->depth = 1;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex)
+{
+  const TaskHandle_t self = GetSelf();
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  if (self != mutex->holder)
+  {
+    return pdFALSE;
+  }
+
+  mutex->holder = nullptr;
+  mutex->depth = 0;
+  GetKernelChanged().notify_all();
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t mutex, TickType_t timeout)
+{
+  const TaskHandle_t self = GetSelf();
+  std::unique_lock<std::mutex> lock {GetKernelMutex()};
+  if (self == mutex->holder)
+  {
+    ++mutex->depth;
+    return pdTRUE;
+  }
+
+  if (!Wait(lock, self, timeout, [mutex]() { return nullptr == mutex->holder; }))
+  {
+    return pdFALSE;
+  }
+
+  mutex->holder = self;
+  mutex->depth = 1;
+  return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t mutex)
+{
+  const TaskHandle_t self = GetSelf();
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  if (self != mutex->holder)
+  {
+    return pdFALSE;
+  }
+
+  if (0 == --mutex->depth)
+  {
+    mutex->holder = nullptr;
+    GetKernelChanged().notify_all();
+  }
+  return pdTRUE;
+}
+
+TaskHandle_t xSemaphoreGetMutexHolder(SemaphoreHandle_t mutex)
+{
+  std::lock_guard<std::mutex> guard {GetKernelMutex()};
+  return mutex->holder;
+}
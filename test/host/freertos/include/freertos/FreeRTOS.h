@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+// The emulated ESP-IDF FreeRTOS kernel of the host tests, it runs each task in a std::thread.
+// Only the API used by the tested sources is provided, see FreeRTOS.cpp for the emulated semantics.
+
+#ifndef HEADER_3D03B3D948F945C08D5130CA9209680A
+#define HEADER_3D03B3D948F945C08D5130CA9209680A
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// The configuration of the emulated kernel, like FreeRTOSConfig.h.
+#define configTICK_RATE_HZ 1000
+#define configMAX_PRIORITIES 25
+#define configMINIMAL_STACK_SIZE 768
+#define configMAX_TASK_NAME_LEN 16
+#define configSUPPORT_STATIC_ALLOCATION 1
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+
+// Like ESP-IDF by default, a single notification index, which is shared by all users of the task notification.
+#if !defined(configTASK_NOTIFICATION_ARRAY_ENTRIES)
+  #define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#define portNUM_PROCESSORS 2
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint8_t StackType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define tskNO_AFFINITY ((BaseType_t)0x7FFFFFFF)
+
+// The spinlock of the critical sections, recursive on the same thread.
+typedef struct
+{
+  std::atomic<uintptr_t> owner;
+  uint32_t count;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {0, 0}
+#define portMUX_NO_TIMEOUT (-1)
+#define portMUX_TRY_LOCK 0
+
+void vPortEnterCritical(portMUX_TYPE* mux);
+void vPortExitCritical(portMUX_TYPE* mux);
+BaseType_t xPortEnterCriticalTimeout(portMUX_TYPE* mux, BaseType_t timeout);
+
+#define taskENTER_CRITICAL(mux) vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL(mux) vPortExitCritical(mux)
+#define taskENTER_CRITICAL_ISR(mux) vPortEnterCritical(mux)
+#define taskEXIT_CRITICAL_ISR(mux) vPortExitCritical(mux)
+#define portTRY_ENTER_CRITICAL(mux, timeout) xPortEnterCriticalTimeout(mux, timeout)
+#define portTRY_ENTER_CRITICAL_ISR(mux, timeout) xPortEnterCriticalTimeout(mux, timeout)
+
+// There are no interrupts and no priorities, yielding at the end of an "ISR" is not required.
+#define portYIELD_FROM_ISR(woken) ((void)(woken))
+
+BaseType_t xPortGetCoreID();
+
+void* pvPortMalloc(size_t size);
+void vPortFree(void* memory);
+
+#endif // HEADER_3D03B3D948F945C08D5130CA9209680A
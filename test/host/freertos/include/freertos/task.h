@@ -0,0 +1,70 @@
+// Copyright (c) 2024 Meik Jaeckle
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#ifndef HEADER_C83D3761CD404955B4878E7B531776AD
+#define HEADER_C83D3761CD404955B4878E7B531776AD
+
+#include <freertos/FreeRTOS.h>
+
+typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef void (*TaskFunction_t)(void* param);
+
+// The emulated task control block is allocated by the kernel, the static buffer is not used.
+typedef struct
+{
+  uint8_t reserved[16];
+} StaticTask_t;
+
+typedef enum
+{
+  eRunning = 0,
+  eReady,
+  eBlocked,
+  eSuspended,
+  eDeleted,
+  eInvalid
+} eTaskState;
+
+typedef struct
+{
+  TickType_t timeOnEntering;
+} TimeOut_t;
+
+TaskHandle_t xTaskCreateStaticPinnedToCore(TaskFunction_t function, const char* name, uint32_t stackDepth, void* param,
+                                           UBaseType_t priority, StackType_t* stack, StaticTask_t* tcb, BaseType_t core);
+void vTaskDelete(TaskHandle_t task);
+void vTaskSuspend(TaskHandle_t task);
+void vTaskResume(TaskHandle_t task);
+eTaskState eTaskGetState(TaskHandle_t task);
+TaskHandle_t xTaskGetCurrentTaskHandle();
+UBaseType_t uxTaskPriorityGet(TaskHandle_t task);
+void vTaskPrioritySet(TaskHandle_t task, UBaseType_t priority);
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+void vTaskDelay(TickType_t ticks);
+TickType_t xTaskGetTickCount();
+void vTaskSetTimeOutState(TimeOut_t* timeOut);
+BaseType_t xTaskCheckForTimeOut(TimeOut_t* timeOut, TickType_t* remaining);
+
+BaseType_t xTaskNotifyGiveIndexed(TaskHandle_t task, UBaseType_t index);
+void vTaskNotifyGiveIndexedFromISR(TaskHandle_t task, UBaseType_t index, BaseType_t* higherPriorityTaskWoken);
+uint32_t ulTaskNotifyTakeIndexed(UBaseType_t index, BaseType_t clearOnExit, TickType_t timeout);
+
+inline BaseType_t xTaskNotifyGive(TaskHandle_t task)
+{
+  return xTaskNotifyGiveIndexed(task, 0);
+}
+
+inline void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken)
+{
+  vTaskNotifyGiveIndexedFromISR(task, 0, higherPriorityTaskWoken);
+}
+
+inline uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t timeout)
+{
+  return ulTaskNotifyTakeIndexed(0, clearOnExit, timeout);
+}
+
+#endif // HEADER_C83D3761CD404955B4878E7B531776AD